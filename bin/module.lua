@@ -80,8 +80,24 @@ print("b1,b2", obj.b1, obj.b2)
 print("c1,c2", obj.c1, obj.c2)
 print("d1,d2", obj.d1, obj.d2)
 print("p1", obj.p1)
+print("a12", obj.a12)
 --print(luabind.TestD.ddd)
 obj.d1 = 9
 obj.c1 = 15
 print(obj.d1, obj.c1)
-obj.p1 = 99
\ No newline at end of file
+obj.p1 = 99
+
+local e1 = luabind.get_e()
+local hits, misses = luabind.identity_stats()
+assert(rawequal(e1, luabind.get_e()) and e1.e == 13)
+local hits2, misses2 = luabind.identity_stats()
+assert(hits2 == hits + 1 and misses2 == misses)
+e1 = nil
+collectgarbage()
+collectgarbage()
+luabind.get_e()
+hits2, misses2 = luabind.identity_stats()
+assert(hits2 == hits + 1 and misses2 == misses + 1)
+local w = luabind.get_weak_e()
+assert(rawequal(w, luabind.get_weak_e()) and not rawequal(w, luabind.get_e()))
+w = nil
\ No newline at end of file
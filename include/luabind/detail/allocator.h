@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus
+//  File name:   allocator.h
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace luabind
+{
+	class pool_allocator
+	{
+	public:
+		static constexpr size_t granularity = LB_POOL_GRANULARITY;
+
+		static constexpr size_t max_size = LB_POOL_MAX_SIZE;
+
+		static constexpr size_t class_count = max_size / granularity;
+
+		static constexpr size_t slab_size = LB_POOL_SLAB_SIZE;
+
+		static_assert(granularity >= sizeof(void*) && (granularity & (granularity - 1)) == 0,
+			"granularity has to be a power of 2 no less than a pointer.");
+
+		static_assert(max_size % granularity == 0 && slab_size >= max_size,
+			"wrong pool size settings.");
+
+		struct stats
+		{
+			size_t live_bytes = 0;
+			size_t peak_bytes = 0;
+			size_t live_count[class_count] = {};
+			size_t total_count[class_count] = {};
+			size_t large_live_count = 0;
+			size_t large_total_count = 0;
+			size_t slab_count = 0;
+		};
+
+		pool_allocator() noexcept = default;
+
+		pool_allocator(const pool_allocator&) = delete;
+
+		pool_allocator& operator = (const pool_allocator&) = delete;
+
+		~pool_allocator() noexcept
+		{
+			for (auto slab : slabs)
+			{
+				free(slab);
+			}
+		}
+
+		lua_State* new_state() noexcept
+		{
+			lua_State* L = lua_newstate(&alloc, this);
+#			if (LUA_VERSION_NUM >= 503)
+			if (L)
+			{
+				memset(lua_getextraspace(L), 0, LUA_EXTRASPACE);
+			}
+#			endif
+			return L;
+		}
+
+		const stats& get_stats() const noexcept
+		{
+			return info;
+		}
+
+		static pool_allocator* get(lua_State* L) noexcept
+		{
+			void* ud = nullptr;
+			return lua_getallocf(L, &ud) == &alloc ? (pool_allocator*)ud : nullptr;
+		}
+
+		static void* alloc(void* ud, void* ptr, size_t osize, size_t nsize) noexcept
+		{
+			auto pool = (pool_allocator*)ud;
+			if (!ptr)
+			{
+				osize = 0;
+			}
+			if (!nsize)
+			{
+				if (ptr)
+				{
+					pool->deallocate(ptr, osize);
+				}
+				return nullptr;
+			}
+			if (!ptr)
+			{
+				return pool->allocate(nsize);
+			}
+			return pool->reallocate(ptr, osize, nsize);
+		}
+
+	private:
+		struct free_node
+		{
+			free_node* next;
+		};
+
+		static size_t size_class(size_t size) noexcept
+		{
+			return (size - 1) / granularity;
+		}
+
+		void* allocate(size_t size) noexcept
+		{
+			void* res;
+			if (size > max_size)
+			{
+				res = malloc(size);
+				if (!res) return nullptr;
+				++info.large_live_count;
+				++info.large_total_count;
+			}
+			else
+			{
+				size_t c = size_class(size);
+				if (!free_lists[c] && !refill(c)) return nullptr;
+				res = free_lists[c];
+				free_lists[c] = free_lists[c]->next;
+				++info.live_count[c];
+				++info.total_count[c];
+			}
+			info.live_bytes += size;
+			if (info.live_bytes > info.peak_bytes)
+			{
+				info.peak_bytes = info.live_bytes;
+			}
+			return res;
+		}
+
+		void deallocate(void* ptr, size_t size) noexcept
+		{
+			info.live_bytes -= size;
+			if (size > max_size)
+			{
+				--info.large_live_count;
+				free(ptr);
+			}
+			else
+			{
+				size_t c = size_class(size);
+				--info.live_count[c];
+				auto node = (free_node*)ptr;
+				node->next = free_lists[c];
+				free_lists[c] = node;
+			}
+		}
+
+		void* reallocate(void* ptr, size_t osize, size_t nsize) noexcept
+		{
+			if (osize > max_size && nsize > max_size)
+			{
+				void* res = realloc(ptr, nsize);
+				if (!res)
+				{
+					if (nsize > osize) return nullptr;
+					res = ptr;
+				}
+				info.live_bytes = info.live_bytes - osize + nsize;
+				if (info.live_bytes > info.peak_bytes)
+				{
+					info.peak_bytes = info.live_bytes;
+				}
+				return res;
+			}
+			if (osize <= max_size && nsize <= max_size && size_class(osize) == size_class(nsize))
+			{
+				info.live_bytes = info.live_bytes - osize + nsize;
+				if (info.live_bytes > info.peak_bytes)
+				{
+					info.peak_bytes = info.live_bytes;
+				}
+				return ptr;
+			}
+			void* res = allocate(nsize);
+			if (!res)
+			{
+				return nsize < osize ? shrink_in_place(ptr, osize, nsize) : nullptr;
+			}
+			memcpy(res, ptr, osize < nsize ? osize : nsize);
+			deallocate(ptr, osize);
+			return res;
+		}
+
+		void* shrink_in_place(void* ptr, size_t osize, size_t nsize) noexcept
+		{
+			//lua does not expect a shrink to fail, so the old block is kept as a
+			//chunk of the smaller class. A large block is adopted like a slab.
+			if (osize > max_size)
+			{
+				slabs.push_back(ptr);
+				--info.large_live_count;
+			}
+			else
+			{
+				--info.live_count[size_class(osize)];
+			}
+			++info.live_count[size_class(nsize)];
+			info.live_bytes = info.live_bytes - osize + nsize;
+			return ptr;
+		}
+
+		bool refill(size_t c) noexcept
+		{
+			char* slab = (char*)malloc(slab_size);
+			if (!slab) return false;
+			slabs.push_back(slab);
+			++info.slab_count;
+			size_t chunk = (c + 1) * granularity;
+			size_t count = slab_size / chunk;
+			for (size_t i = count; i > 0; --i)
+			{
+				auto node = (free_node*)(slab + (i - 1) * chunk);
+				node->next = free_lists[c];
+				free_lists[c] = node;
+			}
+			return true;
+		}
+
+		free_node* free_lists[class_count] = {};
+		std::vector<void*> slabs;
+		stats info;
+
+	};
+}
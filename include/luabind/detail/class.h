@@ -31,13 +31,16 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 namespace luabind
 {
 	enum userdata_type
 	{
 		USERDATA_CLASS,
-		USERDATA_CUSTOMIZED_BEGIN
+		USERDATA_CUSTOMIZED_BEGIN,
+		USERDATA_CUSTOMIZED_END = 0x4000,
+		USERDATA_SPAN = USERDATA_CUSTOMIZED_END
 	};
 
 	enum storage_type
@@ -63,19 +66,27 @@ namespace luabind
 		OBJ_MAX
 	};
 
+	enum class_flag
+	{
+		CLASS_NORMAL = 0x0,
+		CLASS_FLATTEN = 0x1,
+		CLASS_IDENTITY = 0x2,
+		CLASS_LAZY = 0x4
+	};
+
 	template <class... _Types>
 	struct constructor
 	{
 		template <class _Der>
 		static void default_construct_func(void* m, _Types... pak) noexcept
 		{
-			new(m) _Der(pak...);
+			new(m) _Der(std::forward<_Types>(pak)...);
 		}
 
 		template <class _Der>
 		static _Der* default_new_func(_Types... pak) noexcept
 		{
-			return new _Der(pak...);
+			return new _Der(std::forward<_Types>(pak)...);
 		}
 	};
 
@@ -90,6 +101,8 @@ namespace luabind
 
 		static constexpr int params_count = sizeof...(_Types);
 		static constexpr int default_start = idx;
+		static constexpr int min_top = 1 + params_stack_count<0, idx, _Types...>::value;
+		static constexpr int max_top = 1 + params_stack_count<0, params_count, _Types...>::value;
 
 		static bool test(lua_State* L, int top) noexcept
 		{
@@ -117,6 +130,17 @@ namespace luabind
 			int type_id;
 		};
 
+		inline uint32_t class_fingerprint(lua_State* L, int idx) noexcept
+		{
+			header* data = (header*)lua_touserdata(L, idx);
+			if (data->type == USERDATA_CLASS && data->type_id > 0
+				&& data->type_id < (1 << 27))
+			{
+				return (uint32_t(data->type_id) << 4) | uint32_t(data->storage + 1);
+			}
+			return 0;
+		}
+
 		template <class _Ty, storage_type s>
 		struct userdata_obj {};
 
@@ -166,36 +190,30 @@ namespace luabind
 				&& _Shell::default_start >= 1, "wrong construct function.");
 
 			constructor_holder(const func_type& f, const val_type& v) noexcept
-				: func(f), vals(v) {}
+				: func_holder(_Shell::construct_min_top, _Shell::construct_max_top, 1)
+				, func(f), vals(v) {}
 
 			virtual ~constructor_holder() noexcept
 			{
 
 			}
 
-			virtual int call(lua_State* L) noexcept
+			virtual bool test(lua_State* L, int top) noexcept
 			{
-				int top = lua_gettop(L);
-				if (_Shell::construct_test(L, top))
-				{
-					header* data = (header*)lua_newuserdata(L, sizeof(_Der) + sizeof(header));
-					data->type = USERDATA_CLASS;
-					data->storage = STORAGE_LUA;
-					data->type_id = detail::class_info<_Der>::info_data_map[get_main(L)].type_id;
-					func_invoker<1, _Shell::default_start, _Shell, void*>::invoke(
-						func, vals, L, top, data + 1);
-					lua_pushvalue(L, lua_upvalueindex(3));
-					lua_setmetatable(L, -2);
-					return 1;
-				}
-				else if (next)
-				{
-					return next->call(L);
-				}
-				else
-				{
-					return -1;
-				}
+				return _Shell::construct_test(L, top);
+			}
+
+			virtual int invoke(lua_State* L, int top) noexcept
+			{
+				header* data = (header*)lua_newuserdata(L, sizeof(_Der) + sizeof(header));
+				data->type = USERDATA_CLASS;
+				data->storage = STORAGE_LUA;
+				data->type_id = detail::class_info<_Der>::index();
+				func_invoker<1, _Shell::default_start, _Shell, void*>::invoke(
+					func, vals, L, top, data + 1);
+				lua_pushvalue(L, lua_upvalueindex(3));
+				lua_setmetatable(L, -2);
+				return 1;
 			}
 
 			func_type func;
@@ -226,9 +244,19 @@ namespace luabind
 			construct_func(_Shell& f, _Types... pak) noexcept
 				: func(std::move(f.func)), values(pak...) {}
 
+			virtual ~construct_func() noexcept
+			{
+				release_holder(shared);
+			}
+
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				LUABIND_HOLD_STACK(L);
+				bool is_shared = false;
+				func_holder* holder = get_holder(shared, is_shared, [this]() noexcept -> func_holder*
+				{
+					return new constructor_holder<_Der, _Shell>(func, values);
+				});
 
 #				if (LUA_VERSION_NUM >= 503)
 				if (lua_rawgeti(L, -3, INDEX_CONSTRUCTOR) != LUA_TUSERDATA)
@@ -238,13 +266,7 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					void* data = lua_newuserdata(L, sizeof(func_holder*));
-					*(func_holder**)data = new constructor_holder<_Der, _Shell>(func, values);
-					lua_newtable(L);
-					lua_pushstring(L, "__gc");
-					lua_pushcfunction(L, &func_holder::__gc);
-					lua_rawset(L, -3);
-					lua_setmetatable(L, -2);
+					push_holder(L, holder, is_shared);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -5, INDEX_CONSTRUCTOR);
 					lua_pushstring(L, "__call");
@@ -257,23 +279,13 @@ namespace luabind
 				else
 				{
 					func_holder* h = *(func_holder**)lua_touserdata(L, -1);
-					while (true)
-					{
-						if (h->next)
-						{
-							h = h->next;
-						}
-						else
-						{
-							h->next = new constructor_holder<_Der, _Shell>(func, values);
-							break;
-						}
-					}
+					h->append(chain_holder(holder, is_shared));
 				}
 			}
 
 			func_type func;
 			val_type values;
+			mutable func_holder* shared = nullptr;
 		};
 
 		template <class _Der, class _Shell>
@@ -286,45 +298,38 @@ namespace luabind
 				"wrong new function.");
 
 			new_holder(const func_type& f, const val_type& v) noexcept
-				: func(f), vals(v) {}
+				: func_holder(_Shell::min_top, _Shell::max_top), func(f), vals(v) {}
 
 			virtual ~new_holder() noexcept
 			{
 
 			}
 
-			virtual int call(lua_State* L) noexcept
+			virtual bool test(lua_State* L, int top) noexcept
 			{
-				int top = lua_gettop(L);
-				if (_Shell::test(L, top))
+				return _Shell::test(L, top);
+			}
+
+			virtual int invoke(lua_State* L, int top) noexcept
+			{
+				_Der* p = func_invoker<0, _Shell::default_start, _Shell>::invoke(
+					func, vals, L, top);
+				if (p)
 				{
-					_Der* p = func_invoker<0, _Shell::default_start, _Shell>::invoke(
-						func, vals, L, top);
-					if (p)
+					storage_type eType = (storage_type)lua_tointeger(L, lua_upvalueindex(3));
+					switch (eType)
 					{
-						storage_type eType = (storage_type)lua_tointeger(L, lua_upvalueindex(3));
-						switch (eType)
-						{
-						case STORAGE_I_PTR:
-							return object_traits<_Der*>::push(L, p);
-						case STORAGE_U_PTR:
-							return object_traits<std::unique_ptr<_Der>>::push(L, std::unique_ptr<_Der>(p));
-						case STORAGE_S_PTR:
-							return object_traits<std::shared_ptr<_Der>>::push(L, std::shared_ptr<_Der>(p));
-						default:
-							break;
-						}
+					case STORAGE_I_PTR:
+						return object_traits<_Der*>::push(L, p);
+					case STORAGE_U_PTR:
+						return object_traits<std::unique_ptr<_Der>>::push(L, std::unique_ptr<_Der>(p));
+					case STORAGE_S_PTR:
+						return object_traits<std::shared_ptr<_Der>>::push(L, std::shared_ptr<_Der>(p));
+					default:
+						break;
 					}
-					return 0;
-				}
-				else if (next)
-				{
-					return next->call(L);
-				}
-				else
-				{
-					return -1;
 				}
+				return 0;
 			}
 
 			func_type func;
@@ -355,9 +360,19 @@ namespace luabind
 			new_func(_Shell& f, _Types... pak) noexcept
 				: func(std::move(f.func)), values(pak...) {}
 
+			virtual ~new_func() noexcept
+			{
+				release_holder(shared);
+			}
+
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				LUABIND_HOLD_STACK(L);
+				bool is_shared = false;
+				func_holder* holder = get_holder(shared, is_shared, [this]() noexcept -> func_holder*
+				{
+					return new new_holder<_Der, _Shell>(func, values);
+				});
 #				if (LUA_VERSION_NUM >= 503)
 				if (lua_rawgeti(L, -3, INDEX_FUNC) != LUA_TTABLE)
 #				else
@@ -366,7 +381,7 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -5, INDEX_FUNC);
 				}
@@ -380,13 +395,7 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					void* data = lua_newuserdata(L, sizeof(func_holder*));
-					*(func_holder**)data = new new_holder<_Der, _Shell>(func, values);
-					lua_newtable(L);
-					lua_pushstring(L, "__gc");
-					lua_pushcfunction(L, &func_holder::__gc);
-					lua_rawset(L, -3);
-					lua_setmetatable(L, -2);
+					push_holder(L, holder, is_shared);
 					lua_pushstring(L, "new");
 					lua_pushvalue(L, -2);
 					lua_rawset(L, -4);
@@ -422,67 +431,54 @@ namespace luabind
 				else
 				{
 					func_holder* h = *(func_holder**)lua_touserdata(L, -1);
-					while (true)
-					{
-						if (h->next)
-						{
-							h = h->next;
-						}
-						else
-						{
-							h->next = new new_holder<_Der, _Shell>(func, values);
-							break;
-						}
-					}
+					h->append(chain_holder(holder, is_shared));
 				}
 			}
 
 			func_type func;
 			val_type values;
+			mutable func_holder* shared = nullptr;
 		};
 
-		inline void* get_adjusted_ptr(header* data, const class_info_data& info) noexcept
+		inline void* get_origin_ptr(header* data) noexcept
 		{
 			if (data->type == USERDATA_CLASS)
 			{
-				void* origin(nullptr);
 				switch (data->storage)
 				{
 				case STORAGE_LUA:
-					origin = (data + 1);
-					break;
+					return (data + 1);
 				case STORAGE_I_PTR:
-					origin = *(void**)(data + 1);
-					break;
+					return *(void**)(data + 1);
 				case STORAGE_U_PTR:
-					origin = ((std::unique_ptr<void>*)(data + 1))->get();
-					break;
+					return ((std::unique_ptr<void>*)(data + 1))->get();
 				case STORAGE_S_PTR:
-					origin = ((std::shared_ptr<void>*)(data + 1))->get();
-					break;
+					return ((std::shared_ptr<void>*)(data + 1))->get();
 				case STORAGE_W_PTR:
 					if (!(((std::weak_ptr<void>*)(data + 1))->expired()))
 					{
-						origin = ((std::weak_ptr<void>*)(data + 1))->lock().get();
+						return ((std::weak_ptr<void>*)(data + 1))->lock().get();
 					}
 					break;
 				default:
 					break;
 				}
-				if (origin)
+			}
+			return nullptr;
+		}
+
+		inline void* get_adjusted_ptr(header* data, const class_info_data& info) noexcept
+		{
+			void* origin = get_origin_ptr(data);
+			if (origin)
+			{
+				if (info.type_id == data->type_id)
 				{
-					if (info.type_id == data->type_id)
-					{
-						return origin;
-					}
-					else
-					{
-						auto it = info.sub_map.find(data->type_id);
-						if (it != info.sub_map.end())
-						{
-							return (char*)origin + it->second.first;
-						}
-					}
+					return origin;
+				}
+				else if (auto diff = info.find_sub(data->type_id))
+				{
+					return (char*)origin + *diff;
 				}
 			}
 			return nullptr;
@@ -490,6 +486,9 @@ namespace luabind
 
 		struct member_func_holder
 		{
+			member_func_holder(int min, int max) noexcept
+				: origin(this), min_top(min), max_top(max) {}
+
 			virtual ~member_func_holder() noexcept
 			{
 				if (next)
@@ -499,7 +498,41 @@ namespace luabind
 				}
 			}
 
-			virtual int call(lua_State* L, void* obj) noexcept = 0;
+			virtual bool test(lua_State* L, int top) noexcept = 0;
+
+			virtual int invoke(lua_State* L, int top, void* obj) noexcept = 0;
+
+			int call(lua_State* L, void* obj) noexcept
+			{
+				int top = lua_gettop(L);
+				member_func_holder* h = next ? overloads.find(this, L, top)
+					: (test(L, top) ? this : nullptr);
+				return h ? h->invoke(L, top, obj) : -1;
+			}
+
+			void append(member_func_holder* h) noexcept
+			{
+				member_func_holder* tail = this;
+				while (tail->next)
+				{
+					tail = tail->next;
+				}
+				tail->next = h;
+				overloads.reset();
+			}
+
+			void retain() noexcept
+			{
+				++refs;
+			}
+
+			void release() noexcept
+			{
+				if (!--refs)
+				{
+					delete this;
+				}
+			}
 
 			static int __gc(lua_State* L) noexcept
 			{
@@ -525,7 +558,7 @@ namespace luabind
 						}
 						else
 						{
-							return ret;
+							return detail::return_or_yield(L, ret);
 						}
 					}
 				}
@@ -534,17 +567,81 @@ namespace luabind
 			}
 
 			member_func_holder* next = nullptr;
+			member_func_holder* origin;
+			int min_top;
+			int max_top;
+			int base = 1;
+			std::atomic<size_t> refs{ 1 };
+			overload_set<member_func_holder> overloads;
 		};
 
+		//The member function counterpart of shared_func_holder.
+		struct shared_member_func_holder : member_func_holder
+		{
+			shared_member_func_holder(member_func_holder* t) noexcept
+				: member_func_holder(t->min_top, t->max_top), target(t)
+			{
+				origin = t->origin;
+				t->retain();
+			}
+
+			virtual ~shared_member_func_holder() noexcept
+			{
+				target->release();
+			}
+
+			virtual bool test(lua_State* L, int top) noexcept
+			{
+				return target->test(L, top);
+			}
+
+			virtual int invoke(lua_State* L, int top, void* obj) noexcept
+			{
+				return target->invoke(L, top, obj);
+			}
+
+			static int __gc(lua_State* L) noexcept
+			{
+				(*(member_func_holder**)lua_touserdata(L, 1))->~member_func_holder();
+				return 0;
+			}
+
+			member_func_holder* target;
+		};
+
+		inline void push_holder(lua_State* L, member_func_holder* h, bool shared) noexcept
+		{
+			if (shared)
+			{
+				void* data = lua_newuserdata(L, sizeof(member_func_holder*) + sizeof(shared_member_func_holder));
+				*(member_func_holder**)data = new ((member_func_holder**)data + 1) shared_member_func_holder(h);
+				push_gc_meta<&shared_member_func_holder::__gc>(L);
+			}
+			else
+			{
+				*(member_func_holder**)lua_newuserdata(L, sizeof(member_func_holder*)) = h;
+				push_gc_meta<&member_func_holder::__gc>(L);
+			}
+			lua_setmetatable(L, -2);
+		}
+
+		inline member_func_holder* chain_holder(member_func_holder* h, bool shared) noexcept
+		{
+			return shared ? new shared_member_func_holder(h) : h;
+		}
+
 		template <int base, class _Shell>
 		struct do_obj_invoke_normal
 		{
 			static int invoke(typename _Shell::_Class* o, typename _Shell::func_type f,
 				typename _Shell::val_type& v, lua_State* L, int top) noexcept
 			{
-				return type_traits<typename _Shell::ret_type>::push(L,
-					member_func_invoker<base, _Shell::default_start, _Shell>::invoke(
-						o, f, v, L, top));
+				return result_pusher<typename _Shell::ret_type>::push(L,
+					[&]() -> typename _Shell::ret_type
+					{
+						return member_func_invoker<base, _Shell::default_start, _Shell>::invoke(
+							o, f, v, L, top);
+					});
 			}
 		};
 
@@ -567,31 +664,24 @@ namespace luabind
 
 		};
 
-		template <class _Shell>
+		template <class _Der, class _Shell>
 		struct member_func_holder_impl : member_func_holder
 		{
 			typedef typename _Shell::func_type func_type;
 			typedef typename _Shell::val_type val_type;
 
 			member_func_holder_impl(func_type f, const val_type& v) noexcept
-				: func(f), vals(v) {}
+				: member_func_holder(_Shell::min_top, _Shell::max_top), func(f), vals(v) {}
 
-			virtual int call(lua_State* L, void* obj) noexcept
+			virtual bool test(lua_State* L, int top) noexcept
 			{
-				int top = lua_gettop(L);
-				if (_Shell::test(L, top))
-				{
-					return do_obj_invoke<1, _Shell>::invoke((typename _Shell::_Class*)obj,
-						func, vals, L, top);
-				}
-				else if (next)
-				{
-					return next->call(L, obj);
-				}
-				else
-				{
-					return -1;
-				}
+				return _Shell::test(L, top);
+			}
+
+			virtual int invoke(lua_State* L, int top, void* obj) noexcept
+			{
+				return do_obj_invoke<1, _Shell>::invoke(
+					static_cast<typename _Shell::_Class*>((_Der*)obj), func, vals, L, top);
 			}
 
 			func_type func;
@@ -618,7 +708,7 @@ namespace luabind
 #				endif				
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -3, OBJ_FUNC);
 				}
@@ -634,7 +724,81 @@ namespace luabind
 			holder upvalues;
 		};
 
-		template <class _Shell, class... _Types>
+		inline void enroll_member_func(lua_State* L, const char* name, class_info_data* info,
+			member_func_holder* holder, lua_CFunction single,
+			const static_holder_desc<member_func_holder>* desc = nullptr, bool shared = false) noexcept
+		{
+			LUABIND_HOLD_STACK(L);
+			int obj_meta = lua_gettop(L);
+			int meta = obj_meta - 2;
+#			if (LUA_VERSION_NUM >= 503)
+			if (lua_rawgeti(L, obj_meta, OBJ_FUNC_HOLDER) != LUA_TTABLE)
+#			else
+			lua_rawgeti(L, obj_meta, OBJ_FUNC_HOLDER);
+			if (lua_type(L, -1) != LUA_TTABLE)
+#			endif
+			{
+				lua_pop(L, 1);
+				new_table(L);
+				lua_pushvalue(L, -1);
+				lua_rawseti(L, obj_meta, OBJ_FUNC_HOLDER);
+			}
+			lua_pushstring(L, name);
+			lua_rawget(L, -2);
+			if (lua_type(L, -1) == LUA_TLIGHTUSERDATA)
+			{
+				member_func_holder* first = ((const static_holder_desc<member_func_holder>*)
+					lua_touserdata(L, -1))->create();
+				lua_pop(L, 1);
+				push_holder(L, first, false);
+				lua_pushstring(L, name);
+				lua_pushvalue(L, -2);
+				lua_rawset(L, -4);
+			}
+			if (lua_type(L, -1) != LUA_TUSERDATA)
+			{
+				lua_pop(L, 1);
+				if (holder)
+				{
+					push_holder(L, holder, shared);
+				}
+				else
+				{
+					lua_pushlightuserdata(L, (void*)desc);
+				}
+				lua_pushstring(L, name);
+				lua_pushvalue(L, -2);
+				lua_rawset(L, -4);
+			}
+			else
+			{
+				(*(member_func_holder**)lua_touserdata(L, -1))->append(
+					holder ? chain_holder(holder, shared) : desc->create());
+				single = &member_func_holder::entry;
+			}
+			int data = lua_gettop(L);
+#			if (LUA_VERSION_NUM >= 503)
+			if (lua_rawgeti(L, obj_meta, OBJ_FUNC) != LUA_TTABLE)
+#			else
+			lua_rawgeti(L, obj_meta, OBJ_FUNC);
+			if (lua_type(L, -1) != LUA_TTABLE)
+#			endif
+			{
+				lua_pop(L, 1);
+				new_table(L);
+				lua_pushvalue(L, -1);
+				lua_rawseti(L, obj_meta, OBJ_FUNC);
+			}
+			lua_pushstring(L, name);
+			lua_pushlightuserdata(L, info);
+			lua_pushvalue(L, data);
+			lua_rawgeti(L, meta, INDEX_SCOPE_NAME);
+			lua_pushstring(L, name);
+			lua_pushcclosure(L, single, 4);
+			lua_rawset(L, -3);
+		}
+
+		template <class _Der, class _Shell, class... _Types>
 		struct member_func : enrollment
 		{
 			typedef typename _Shell::func_type func_type;
@@ -643,90 +807,139 @@ namespace luabind
 			member_func(const char* n, _Shell& f, _Types... pak) noexcept
 				: name(n), func(f.func), values(pak...) {}
 
+			virtual ~member_func() noexcept
+			{
+				release_holder(shared);
+			}
+
 			virtual void enroll(lua_State* L) const noexcept
 			{
-				LUABIND_HOLD_STACK(L);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawgeti(L, -1, OBJ_FUNC_HOLDER) != LUA_TTABLE)
-#				else
-				lua_rawgeti(L, -1, OBJ_FUNC_HOLDER);
-				if (lua_type(L, -1) != LUA_TTABLE)
-#				endif				
-				{
-					lua_pop(L, 1);
-					lua_newtable(L);
-					lua_pushvalue(L, -1);
-					lua_rawseti(L, -3, OBJ_FUNC_HOLDER);
-				}
-				lua_pushstring(L, name);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawget(L, -2) != LUA_TUSERDATA)
-#				else
-				lua_rawget(L, -2);
-				if (lua_type(L, -1) != LUA_TUSERDATA)
-#				endif
+				bool is_shared = false;
+				member_func_holder* h = get_holder(shared, is_shared,
+					[this]() noexcept -> member_func_holder*
 				{
-					lua_pop(L, 1);
-					lua_pushlightuserdata(L, &class_info<typename _Shell::_Class>::info_data_map[get_main(L)]);
-					void* data = lua_newuserdata(L, sizeof(func_holder*));
-					*(member_func_holder**)data = new member_func_holder_impl<_Shell>(func, values);
-					lua_newtable(L);
-					lua_pushstring(L, "__gc");
-					lua_pushcfunction(L, &member_func_holder::__gc);
-					lua_rawset(L, -3);
-					lua_setmetatable(L, -2);
-					lua_pushstring(L, name);
-					lua_pushvalue(L, -2);
-					lua_rawset(L, -5);
+					return new member_func_holder_impl<_Der, _Shell>(func, values);
+				});
+				enroll_member_func(L, name, &get_env(L)->get_class<_Der>(),
+					h, &member_func_holder::entry, nullptr, is_shared);
+			}
 
-					lua_rawgeti(L, -6, INDEX_SCOPE_NAME);
-					lua_pushstring(L, name);
-					lua_pushcclosure(L, &member_func_holder::entry, 4);
-#					if (LUA_VERSION_NUM >= 503)
-					if (lua_rawgeti(L, -3, OBJ_FUNC) != LUA_TTABLE)
-#					else
-					lua_rawgeti(L, -3, OBJ_FUNC);
-					if (lua_type(L, -1) != LUA_TTABLE)
-#					endif
-					{
-						lua_pop(L, 1);
-						lua_newtable(L);
-						lua_pushvalue(L, -1);
-						lua_rawseti(L, -5, OBJ_FUNC);
-					}
-					lua_pushstring(L, name);
-					lua_pushvalue(L, -3);
-					lua_rawset(L, -3);
-				}
-				else
+			const char* name;
+			func_type func;
+			val_type values;
+			mutable member_func_holder* shared = nullptr;
+		};
+
+		template <class _Der, class _Shell, typename _Shell::func_type _Target>
+		struct static_member_func_holder : member_func_holder
+		{
+			typedef typename _Shell::val_type val_type;
+
+			static_member_func_holder(const val_type& v) noexcept
+				: member_func_holder(_Shell::min_top, _Shell::max_top), vals(v) {}
+
+			virtual bool test(lua_State* L, int top) noexcept
+			{
+				return _Shell::test(L, top);
+			}
+
+			virtual int invoke(lua_State* L, int top, void* obj) noexcept
+			{
+				return do_obj_invoke<1, _Shell>::invoke(
+					static_cast<typename _Shell::_Class*>((_Der*)obj), _Target, vals, L, top);
+			}
+
+			static int entry(lua_State* L) noexcept
+			{
+				if (lua_type(L, 1) == LUA_TUSERDATA)
 				{
-					member_func_holder* h = *(member_func_holder**)lua_touserdata(L, -1);
-					while (true)
+					void* ptr = get_adjusted_ptr((header*)lua_touserdata(L, 1),
+						*(class_info_data*)lua_touserdata(L, lua_upvalueindex(1)));
+					if (ptr)
 					{
-						if (h->next)
-						{
-							h = h->next;
-						}
-						else
+						int top = lua_gettop(L);
+						if (_Shell::test(L, top))
 						{
-							h->next = new member_func_holder_impl<_Shell>(func, values);
-							break;
+							return detail::return_or_yield(L, do_obj_invoke<1, _Shell>::invoke(
+								static_cast<typename _Shell::_Class*>((_Der*)ptr), _Target, get_vals(L, std::integral_constant<bool,
+									(std::tuple_size<val_type>::value > 0)>()), L, top));
 						}
+						return luaL_error(L, "call c++ member function[%s:%s] with wrong params.",
+							lua_tostring(L, lua_upvalueindex(3)), lua_tostring(L, lua_upvalueindex(4)));
 					}
 				}
+				return luaL_error(L, "call c++ member function[%s:%s] with invalid object.",
+					lua_tostring(L, lua_upvalueindex(3)), lua_tostring(L, lua_upvalueindex(4)));
+			}
+
+			static val_type& get_vals(lua_State* L, std::true_type) noexcept
+			{
+				return ((static_member_func_holder*)(*(member_func_holder**)lua_touserdata(
+					L, lua_upvalueindex(2)))->origin)->vals;
+			}
+
+			static val_type& get_vals(lua_State* L, std::false_type) noexcept
+			{
+				static val_type none;
+				return none;
+			}
+
+			static member_func_holder* create()
+			{
+				return new static_member_func_holder(val_type());
+			}
+
+			static const static_holder_desc<member_func_holder>* desc() noexcept
+			{
+				static const static_holder_desc<member_func_holder> d = { &create };
+				return &d;
+			}
+
+			val_type vals;
+		};
+
+		template <class _Der, class _Shell, typename _Shell::func_type _Target, class... _Types>
+		struct static_member_func : enrollment
+		{
+			typedef static_member_func_holder<_Der, _Shell, _Target> holder;
+			typedef typename _Shell::val_type val_type;
+
+			static_member_func(const char* n, _Types... pak) noexcept
+				: name(n), values(pak...) {}
+
+			virtual ~static_member_func() noexcept
+			{
+				release_holder(shared);
+			}
+
+			virtual void enroll(lua_State* L) const noexcept
+			{
+				bool is_shared = false;
+				member_func_holder* h = nullptr;
+				if (std::tuple_size<val_type>::value)
+				{
+					h = get_holder(shared, is_shared, [this]() noexcept -> member_func_holder*
+					{
+						return new holder(values);
+					});
+				}
+				enroll_member_func(L, name, &get_env(L)->get_class<_Der>(),
+					h, &holder::entry, holder::desc(), is_shared);
 			}
 
 			const char* name;
-			func_type func;
 			val_type values;
+			mutable member_func_holder* shared = nullptr;
 		};
 
-		inline int inherit_index(lua_State* L) noexcept
+		inline int inherit_index(lua_State* L, int meta) noexcept
 		{
+			luaL_checkstack(L, 4, "too many nested base classes");
+			int top = lua_gettop(L);
 #			if (LUA_VERSION_NUM >= 503)
-			if (lua_rawgeti(L, -1, OBJ_FUNC) == LUA_TTABLE)
+			if (lua_rawgeti(L, meta, OBJ_FUNC) == LUA_TTABLE)
 #			else
-			lua_rawgeti(L, -1, OBJ_FUNC);
+			lua_rawgeti(L, meta, OBJ_FUNC);
 			if (lua_type(L, -1) == LUA_TTABLE)
 #			endif
 			{
@@ -741,38 +954,26 @@ namespace luabind
 					return 1;
 				}
 			}
-			lua_settop(L, 3);
+			lua_settop(L, top);
 #			if (LUA_VERSION_NUM >= 503)
-			if (lua_rawgeti(L, -1, OBJ_READER) == LUA_TTABLE)
+			if (lua_rawgeti(L, meta, OBJ_READER) == LUA_TTABLE)
 #			else
-			lua_rawgeti(L, -1, OBJ_READER);
+			lua_rawgeti(L, meta, OBJ_READER);
 			if (lua_type(L, -1) == LUA_TTABLE)
-#			endif			
+#			endif
 			{
 				lua_pushvalue(L, 2);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawget(L, -2) == LUA_TFUNCTION)
-#				else
 				lua_rawget(L, -2);
-				if (lua_type(L, -1) == LUA_TFUNCTION)
-#				endif
+				if (is_accessor(L, -1))
 				{
-					lua_pushvalue(L, 1);
-					if (lua_pcall(L, 1, 1, 0))
-					{
-						return luaL_error(L, lua_tostring(L, -1));
-					}
-					else
-					{
-						return 1;
-					}
+					return call_reader(L, 1);
 				}
 			}
-			lua_settop(L, 3);
+			lua_settop(L, top);
 #			if (LUA_VERSION_NUM >= 503)
-			if (lua_rawgeti(L, -1, OBJ_SUPER) == LUA_TTABLE)
+			if (lua_rawgeti(L, meta, OBJ_SUPER) == LUA_TTABLE)
 #			else
-			lua_rawgeti(L, -1, OBJ_SUPER);
+			lua_rawgeti(L, meta, OBJ_SUPER);
 			if (lua_type(L, -1) == LUA_TTABLE)
 #			endif
 			{
@@ -794,30 +995,15 @@ namespace luabind
 					if (lua_type(L, -1) == LUA_TTABLE)
 #					endif
 					{
-#						if (LUA_VERSION_NUM >= 503)
-						if (lua_rawgeti(L, -1, OBJ_INDEX) == LUA_TFUNCTION)
-#						else
-						lua_rawgeti(L, -1, OBJ_INDEX);
-						if (lua_type(L, -1) == LUA_TFUNCTION)
-#						endif						
+						if (inherit_index(L, lua_gettop(L)) && lua_type(L, -1) > LUA_TNIL)
 						{
-							lua_pushvalue(L, 1);
-							lua_pushvalue(L, 2);
-							lua_pushvalue(L, 5);
-							if (lua_pcall(L, 3, 1, 0))
-							{
-								return luaL_error(L, lua_tostring(L, -1));
-							}
-
-							else if (lua_type(L, -1) > LUA_TNIL)
-							{
-								return 1;
-							}
+							return 1;
 						}
 					}
-					lua_settop(L, 4);
+					lua_settop(L, top + 1);
 				}
 			}
+			lua_settop(L, top);
 			return 0;
 		}
 
@@ -825,69 +1011,195 @@ namespace luabind
 		{
 			if (lua_getmetatable(L, 1))
 			{
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawgeti(L, -1, OBJ_INDEX) == LUA_TFUNCTION)
+				if (inherit_index(L, 3) && lua_type(L, -1) > LUA_TNIL)
+				{
+					return 1;
+				}
+				return luaL_error(L, "can not find readable symbol %s in an instance of %s",
+					lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+			}
+			return luaL_error(L, "wrong registered info in an instance of %s",
+				lua_tostring(L, lua_upvalueindex(1)));
+		}
+
+		inline int inherit_newindex(lua_State* L, int meta) noexcept
+		{
+			luaL_checkstack(L, 4, "too many nested base classes");
+			int top = lua_gettop(L);
+#			if (LUA_VERSION_NUM >= 503)
+			if (lua_rawgeti(L, meta, OBJ_WRITER) == LUA_TTABLE)
+#			else
+			lua_rawgeti(L, meta, OBJ_WRITER);
+			if (lua_type(L, -1) == LUA_TTABLE)
+#			endif
+			{
+				lua_pushvalue(L, 2);
+				lua_rawget(L, -2);
+				if (is_accessor(L, -1))
+				{
+					return call_writer(L, 1, 3);
+				}
+			}
+			lua_settop(L, top);
+#			if (LUA_VERSION_NUM >= 503)
+			if (lua_rawgeti(L, meta, OBJ_SUPER) == LUA_TTABLE)
+#			else
+			lua_rawgeti(L, meta, OBJ_SUPER);
+			if (lua_type(L, -1) == LUA_TTABLE)
+#			endif
+			{
+				size_t len;
+#				if (LUA_VERSION_NUM >= 502)
+				len = lua_rawlen(L, -1);
 #				else
-				lua_rawgeti(L, -1, OBJ_INDEX);
-				if (lua_type(L, -1) == LUA_TFUNCTION)
+				lua_pushstring(L, "len");
+				lua_rawget(L, -2);
+				len = lua_tointeger(L, -1);
+				lua_pop(L, 1);
 #				endif
+				for (size_t i(0); i < len; ++i)
 				{
-					lua_pushvalue(L, 1);
-					lua_pushvalue(L, 2);
-					lua_pushvalue(L, 3);
-					if (lua_pcall(L, 3, 1, 0))
-					{
-						return luaL_error(L, lua_tostring(L, -1));
-					}
-					else if (lua_type(L, -1) > LUA_TNIL)
-					{
-						return 1;
-					}
-					else
+#					if (LUA_VERSION_NUM >= 503)
+					if (lua_rawgeti(L, -1, i + 1) == LUA_TTABLE)
+#					else
+					lua_rawgeti(L, -1, int(i + 1));
+					if (lua_type(L, -1) == LUA_TTABLE)
+#					endif
 					{
-						return luaL_error(L, "can not find readable symbol %s in an instance of %s",
-							lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+						int res = inherit_newindex(L, lua_gettop(L));
+						if (res != WRITER_STATUS_MISSING)
+						{
+							return res;
+						}
 					}
+					lua_settop(L, top + 1);
 				}
 			}
+			lua_settop(L, top);
+			return WRITER_STATUS_MISSING;
+		}
+
+		inline int writer_error(lua_State* L, int res) noexcept
+		{
+			if (res == WRITER_SUCCEEDED)
+			{
+				return 0;
+			}
+			lua_getglobal(L, "tostring");
+			lua_pushvalue(L, 3);
+			lua_call(L, 1, 1);
+			switch (res)
+			{
+			case WRITER_STATUS_MISSING:
+				return luaL_error(L, "can not find writable symbol %s in an instance of %s.",
+					lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+			case WRITER_STATUS_INVALID:
+				return luaL_error(L, "writer %s in an instance of %s is invalid.",
+					lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+			case WRITER_TYPE_FAILED:
+				return luaL_error(L, "The type of %s is not suitable for symbol %s in an instance of %s.",
+					lua_tostring(L, -1), lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+			case WRITER_VALUE_FAILED:
+				return luaL_error(L, "%s is not a valid value for symbol %s in an instance of %s.",
+					lua_tostring(L, -1), lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+			default:
+				return luaL_error(L, "\"%s.%s = %s\" causing a unknown writer error.",
+					lua_tostring(L, lua_upvalueindex(1)), lua_tostring(L, 2), lua_tostring(L, -1));
+			}
+		}
+
+		inline int obj_newindex(lua_State* L) noexcept
+		{
+			if (lua_getmetatable(L, 1))
+			{
+				return writer_error(L, inherit_newindex(L, 4));
+			}
 			return luaL_error(L, "wrong registered info in an instance of %s",
 				lua_tostring(L, lua_upvalueindex(1)));
 		}
 
-		inline int inherit_newindex(lua_State* L) noexcept
+		inline int flat_index(lua_State* L) noexcept
 		{
+			lua_pushvalue(L, 2);
 #			if (LUA_VERSION_NUM >= 503)
-			if (lua_rawgeti(L, -1, OBJ_WRITER) == LUA_TTABLE)
+			if (lua_rawget(L, lua_upvalueindex(2)) == LUA_TFUNCTION)
 #			else
-			lua_rawgeti(L, -1, OBJ_WRITER);
+			lua_rawget(L, lua_upvalueindex(2));
+			if (lua_type(L, -1) == LUA_TFUNCTION)
+#			endif
+			{
+				return 1;
+			}
+			lua_pop(L, 1);
+			lua_pushvalue(L, 2);
+			lua_rawget(L, lua_upvalueindex(3));
+			if (is_accessor(L, -1) && call_reader(L, 1) && lua_type(L, -1) > LUA_TNIL)
+			{
+				return 1;
+			}
+			return luaL_error(L, "can not find readable symbol %s in an instance of %s",
+				lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
+		}
+
+		inline int flat_newindex(lua_State* L) noexcept
+		{
+			lua_pushvalue(L, 2);
+			lua_rawget(L, lua_upvalueindex(2));
+			if (is_accessor(L, -1))
+			{
+				int res = call_writer(L, 1, 3);
+				return writer_error(L, res == detail::WRITER_STATUS_MISSING ? detail::WRITER_STATUS_INVALID : res);
+			}
+			return writer_error(L, WRITER_STATUS_MISSING);
+		}
+
+		inline void flat_copy(lua_State* L, int meta, int src, int dst, int claim) noexcept
+		{
+#			if (LUA_VERSION_NUM >= 503)
+			if (lua_rawgeti(L, meta, src) == LUA_TTABLE)
+#			else
+			lua_rawgeti(L, meta, src);
 			if (lua_type(L, -1) == LUA_TTABLE)
 #			endif
 			{
-				lua_pushvalue(L, 2);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawget(L, -2) == LUA_TFUNCTION)
-#				else
-				lua_rawget(L, -2);
-				if (lua_type(L, -1) == LUA_TFUNCTION)
-#				endif				
+				lua_pushnil(L);
+				while (lua_next(L, -2))
 				{
-					lua_pushvalue(L, 1);
-					lua_pushvalue(L, 3);
-					if (lua_pcall(L, 2, 1, 0))
+					lua_pushvalue(L, -2);
+					lua_rawget(L, dst);
+					bool claimed = lua_type(L, -1) > LUA_TNIL;
+					lua_pop(L, 1);
+					if (!claimed)
+					{
+						lua_pushvalue(L, -2);
+						lua_rawget(L, claim);
+						claimed = lua_type(L, -1) > LUA_TNIL;
+						lua_pop(L, 1);
+					}
+					if (claimed)
 					{
-						return luaL_error(L, lua_tostring(L, -1));
+						lua_pop(L, 1);
 					}
 					else
 					{
-						return 1;
+						lua_pushvalue(L, -2);
+						lua_insert(L, -2);
+						lua_rawset(L, dst);
 					}
 				}
 			}
-			lua_settop(L, 4);
+			lua_pop(L, 1);
+		}
+
+		inline void flat_merge(lua_State* L, int meta, int func, int reader, int writer) noexcept
+		{
+			flat_copy(L, meta, OBJ_FUNC, func, reader);
+			flat_copy(L, meta, OBJ_READER, reader, func);
+			flat_copy(L, meta, OBJ_WRITER, writer, writer);
 #			if (LUA_VERSION_NUM >= 503)
-			if (lua_rawgeti(L, -1, OBJ_SUPER) == LUA_TTABLE)
+			if (lua_rawgeti(L, meta, OBJ_SUPER) == LUA_TTABLE)
 #			else
-			lua_rawgeti(L, -1, OBJ_SUPER);
+			lua_rawgeti(L, meta, OBJ_SUPER);
 			if (lua_type(L, -1) == LUA_TTABLE)
 #			endif
 			{
@@ -902,100 +1214,117 @@ namespace luabind
 #				endif
 				for (size_t i(0); i < len; ++i)
 				{
-#					if (LUA_VERSION_NUM >= 503)
-					if (lua_rawgeti(L, -1, i + 1) == LUA_TTABLE)
-#					else
-					lua_rawgeti(L, -1, int(i + 1));
-					if (lua_type(L, -1) == LUA_TTABLE)
-#					endif					
-					{
-#						if (LUA_VERSION_NUM >= 503)
-						if (lua_rawgeti(L, -1, OBJ_NEW_INDEX) == LUA_TFUNCTION)
-#						else
-						lua_rawgeti(L, -1, OBJ_NEW_INDEX);
-						if (lua_type(L, -1) == LUA_TFUNCTION)
-#						endif
-						{
-							lua_pushvalue(L, 1);
-							lua_pushvalue(L, 2);
-							lua_pushvalue(L, 3);
-							lua_pushvalue(L, 6);
-							if (lua_pcall(L, 4, 1, 0))
-							{
-								return luaL_error(L, lua_tostring(L, -1));
-							}
-
-							else if (lua_type(L, -1) > LUA_TNIL)
-							{
-								return 1;
-							}
-						}
-					}
-					lua_settop(L, 5);
+					lua_rawgeti(L, -1, int(i + 1));
+					if (lua_type(L, -1) == LUA_TTABLE)
+					{
+						flat_merge(L, lua_gettop(L), func, reader, writer);
+					}
+					lua_pop(L, 1);
+				}
+			}
+			lua_pop(L, 1);
+		}
+
+		inline void flatten(lua_State* L, const class_info_data& info) noexcept
+		{
+			LUABIND_HOLD_STACK(L);
+			LB_ASSERT(info.class_id);
+			lua_rawgeti(L, LUA_REGISTRYINDEX, info.class_id);
+			LB_ASSERT_EQ(lua_getmetatable(L, -1), 1);
+			int meta = lua_gettop(L);
+			lua_rawgeti(L, meta, INDEX_CLASS);
+			LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
+			int obj_meta = lua_gettop(L);
+			lua_newtable(L);
+			lua_newtable(L);
+			lua_newtable(L);
+			flat_merge(L, obj_meta, obj_meta + 1, obj_meta + 2, obj_meta + 3);
+			lua_pushstring(L, "__index");
+			lua_rawgeti(L, meta, INDEX_SCOPE_NAME);
+			lua_pushvalue(L, obj_meta + 1);
+			lua_pushvalue(L, obj_meta + 2);
+			lua_pushcclosure(L, &flat_index, 3);
+			lua_rawset(L, obj_meta);
+			lua_pushstring(L, "__newindex");
+			lua_rawgeti(L, meta, INDEX_SCOPE_NAME);
+			lua_pushvalue(L, obj_meta + 3);
+			lua_pushcclosure(L, &flat_newindex, 2);
+			lua_rawset(L, obj_meta);
+		}
+
+		inline void reflatten(lua_State* L, const class_info_data& info) noexcept
+		{
+			if (info.flags & CLASS_FLATTEN)
+			{
+				flatten(L, info);
+			}
+			env& e = *get_env(L);
+			for (size_t i(0); i < info.sub_cast.size(); ++i)
+			{
+				if (info.sub_cast[i] == class_info_data::no_cast() || int(i) == info.type_id)
+				{
+					continue;
+				}
+				class_info_data* sub = e.find_class(i);
+				if (sub && sub->meta_ref && (sub->flags & CLASS_FLATTEN))
+				{
+					flatten(L, *sub);
 				}
 			}
-			return 0;
 		}
 
-		inline int obj_newindex(lua_State* L) noexcept
+		inline void materialize(lua_State* L, class_info_data* info) noexcept
 		{
-			if (lua_getmetatable(L, 1))
+			if (!info->meta_ref && info->lazy_ref)
 			{
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawgeti(L, -1, OBJ_NEW_INDEX) == LUA_TFUNCTION)
-#				else
-				lua_rawgeti(L, -1, OBJ_NEW_INDEX);
-				if (lua_type(L, -1) == LUA_TFUNCTION)
-#				endif
-				{
-					lua_pushvalue(L, 1);
-					lua_pushvalue(L, 2);
-					lua_pushvalue(L, 3);
-					lua_pushvalue(L, 4);
-					if (lua_pcall(L, 4, 1, 0))
-					{
-						return luaL_error(L, lua_tostring(L, -1));
-					}
-					else if (lua_type(L, -1) == LUA_TNUMBER)
-					{
-						auto res = lua_tointeger(L, -1);
-						if (res == WRITER_SUCCEEDED)
-						{
-							return 0;
-						}
-						else
-						{
-							lua_getglobal(L, "tostring");
-							lua_pushvalue(L, 3);
-							lua_call(L, 1, 1);
-							switch (res)
-							{
-							case WRITER_TYPE_FAILED:
-								return luaL_error(L, "The type of %s is not suitable for symbol %s in an instance of %s.",
-									lua_tostring(L, -1), lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
-							case WRITER_VALUE_FAILED:
-								return luaL_error(L, "%s is not a valid value for symbol %s in an instance of %s.",
-									lua_tostring(L, -1), lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
-							default:
-								return luaL_error(L, "\"%s.%s = %s\" causing a unknown writer error.",
-									lua_tostring(L, lua_upvalueindex(1)), lua_tostring(L, 2), lua_tostring(L, -1));
-							}
-						}
-					}
-					else if (lua_type(L, -1) == LUA_TNIL)
-					{
-						return luaL_error(L, "can not find writable symbol %s in an instance of %s.",
-							lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
-					}
-					else
-					{
-						return luaL_error(L, "writer %s in an instance of %s is invalid.",
-							lua_tostring(L, 2), lua_tostring(L, lua_upvalueindex(1)));
-					}
-				}
+				lua_rawgeti(L, LUA_REGISTRYINDEX, info->lazy_ref);
+				lua_call(L, 0, 0);
 			}
-			return luaL_error(L, "wrong registered info in an instance of %s",
-				lua_tostring(L, lua_upvalueindex(1)));
+		}
+
+		inline int lazy_index(lua_State* L) noexcept
+		{
+			lua_pushvalue(L, lua_upvalueindex(1));
+			lua_call(L, 0, 0);
+			lua_gettable(L, 1);
+			return 1;
+		}
+
+		inline int lazy_newindex(lua_State* L) noexcept
+		{
+			lua_pushvalue(L, lua_upvalueindex(1));
+			lua_call(L, 0, 0);
+			lua_settable(L, 1);
+			return 0;
+		}
+
+		inline int lazy_call(lua_State* L) noexcept
+		{
+			int top = lua_gettop(L);
+			lua_pushvalue(L, lua_upvalueindex(1));
+			lua_call(L, 0, 0);
+			lua_call(L, top - 1, LUA_MULTRET);
+			return lua_gettop(L);
+		}
+
+		inline void set_lazy_meta(lua_State* L, int cls) noexcept
+		{
+			LUABIND_HOLD_STACK(L);
+			int func = lua_gettop(L);
+			lua_createtable(L, 0, 3);
+			lua_pushstring(L, "__index");
+			lua_pushvalue(L, func);
+			lua_pushcclosure(L, &lazy_index, 1);
+			lua_rawset(L, -3);
+			lua_pushstring(L, "__newindex");
+			lua_pushvalue(L, func);
+			lua_pushcclosure(L, &lazy_newindex, 1);
+			lua_rawset(L, -3);
+			lua_pushstring(L, "__call");
+			lua_pushvalue(L, func);
+			lua_pushcclosure(L, &lazy_call, 1);
+			lua_rawset(L, -3);
+			lua_setmetatable(L, cls);
 		}
 
 		template <class _Der, class... _Types>
@@ -1018,12 +1347,12 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -3, OBJ_READER);
 				}
 				lua_pushstring(L, name);
-				lua_pushlightuserdata(L, &class_info<_Der>::info_data_map[get_main(L)]);
+				lua_pushlightuserdata(L, &get_env(L)->get_class<_Der>());
 				LB_ASSERT_EQ(type_traits<holder>::push(L, upvalues),
 					type_traits<holder>::stack_count);
 				lua_pushcclosure(L, func, type_traits<holder>::stack_count + 1);
@@ -1035,41 +1364,94 @@ namespace luabind
 			holder upvalues;
 		};
 
+		struct member_accessor : accessor
+		{
+			class_info_data* info = nullptr;
+		};
+
+		template <class _Der, int _Slot, class _Accessor>
+		struct member_accessor_def : enrollment
+		{
+			static_assert(std::is_base_of<member_accessor, _Accessor>::value,
+				"_Accessor need to be a member accessor.");
+
+			member_accessor_def(const char* n, _Accessor&& a) noexcept
+				: name(n), acc(std::move(a)) {}
+
+			virtual void enroll(lua_State* L) const noexcept
+			{
+				LUABIND_HOLD_STACK(L);
+#				if (LUA_VERSION_NUM >= 503)
+				if (lua_rawgeti(L, -1, _Slot) != LUA_TTABLE)
+#				else
+				lua_rawgeti(L, -1, _Slot);
+				if (lua_type(L, -1) != LUA_TTABLE)
+#				endif
+				{
+					lua_pop(L, 1);
+					new_table(L);
+					lua_pushvalue(L, -1);
+					lua_rawseti(L, -3, _Slot);
+				}
+				lua_pushstring(L, name);
+				accessor::push(L, acc)->info = &get_env(L)->get_class<_Der>();
+				lua_rawset(L, -3);
+			}
+
+			const char* name;
+			_Accessor acc;
+		};
+
 		template <class _Der, class _Type>
-		int value_member_reader(lua_State* L) noexcept
+		struct value_member_reader : member_accessor
 		{
 			static_assert(type_traits<_Type>::can_push
 				&& type_traits<_Type>::stack_count == 1, "wrong type for reader.");
-			if (lua_type(L, 1) == LUA_TUSERDATA)
+
+			value_member_reader(_Type _Der::* v) noexcept : val(v) {}
+
+			virtual int read(lua_State* L, int self) noexcept
 			{
-				_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, 1),
-					*(class_info_data*)lua_touserdata(L, lua_upvalueindex(1)));
-				if (obj)
+				if (lua_type(L, self) == LUA_TUSERDATA)
 				{
-					auto v = type_traits<_Type _Der::*>::get(L, lua_upvalueindex(2));
-					return type_traits<_Type>::push(L, obj->*v);
+					_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, self), *info);
+					if (obj)
+					{
+						return type_traits<_Type>::push(L, obj->*val);
+					}
 				}
+				return 0;
 			}
-			return 0;
-		}
+
+			_Type _Der::* val;
+		};
 
 		template <class _Der, class _Type>
-		int member_reader(lua_State* L) noexcept
+		struct member_reader : member_accessor
 		{
 			static_assert(type_traits<_Type>::can_push
 				&& type_traits<_Type>::stack_count == 1, "wrong type for reader.");
-			if (lua_type(L, 1) == LUA_TUSERDATA)
+
+			static_assert(!is_yield_result<_Type>::value,
+				"yield_result can only be returned by functions bound with def.");
+
+			member_reader(_Type(_Der::*f)()) noexcept : func(f) {}
+
+			virtual int read(lua_State* L, int self) noexcept
 			{
-				_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, 1),
-					*(class_info_data*)lua_touserdata(L, lua_upvalueindex(1)));
-				if (obj)
+				if (lua_type(L, self) == LUA_TUSERDATA)
 				{
-					auto f = type_traits<_Type(_Der::*)()>::get(L, lua_upvalueindex(2));
-					return type_traits<_Type>::push(L, (obj->*f)());
+					_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, self), *info);
+					if (obj)
+					{
+						return type_traits<_Type>::push(L, (obj->*func)());
+					}
 				}
+				return 0;
 			}
-			return 0;
-		}
+
+			_Type(_Der::*func)();
+		};
 
 		template <class _Der, class... _Types>
 		struct manual_member_writer : enrollment
@@ -1091,12 +1473,12 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -3, OBJ_WRITER);
 				}
 				lua_pushstring(L, name);
-				lua_pushlightuserdata(L, &class_info<_Der>::info_data_map[get_main(L)]);
+				lua_pushlightuserdata(L, &get_env(L)->get_class<_Der>());
 				LB_ASSERT_EQ(type_traits<holder>::push(L, upvalues),
 					type_traits<holder>::stack_count);
 				lua_pushcclosure(L, func, type_traits<holder>::stack_count + 1);
@@ -1109,66 +1491,118 @@ namespace luabind
 		};
 
 		template <class _Der, class _Type>
-		int value_member_writer(lua_State* L) noexcept
+		struct value_member_writer : member_accessor
 		{
 			static_assert(type_traits<_Type>::can_get
 				&& type_traits<_Type>::stack_count == 1, "wrong type for writer.");
-			if (lua_type(L, 1) == LUA_TUSERDATA)
+
+			value_member_writer(_Type _Der::* v) noexcept : val(v) {}
+
+			virtual int write(lua_State* L, int self, int idx) noexcept
 			{
-				_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, 1),
-					*(class_info_data*)lua_touserdata(L, lua_upvalueindex(1)));
-				if (obj)
+				if (lua_type(L, self) == LUA_TUSERDATA)
 				{
-					if (type_traits<_Type>::test(L, -1))
+					_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, self), *info);
+					if (obj)
 					{
-						auto v = type_traits<_Type _Der::*>::get(L, lua_upvalueindex(2));
-						(obj->*v) = type_traits<_Type>::get(L, -1);
-						lua_pushinteger(L, WRITER_SUCCEEDED);
-					}
-					else
-					{
-						lua_pushinteger(L, WRITER_TYPE_FAILED);
+						if (type_traits<_Type>::test(L, idx))
+						{
+							(obj->*val) = type_traits<_Type>::get(L, idx);
+							return WRITER_SUCCEEDED;
+						}
+						return WRITER_TYPE_FAILED;
 					}
-					return 1;
 				}
+				return WRITER_UNKNOWN_FIALED;
 			}
-			lua_pushinteger(L, WRITER_UNKNOWN_FIALED);
-			return 1;
-		}
+
+			_Type _Der::* val;
+		};
 
 		template <class _Der, class _Type>
-		int member_writer(lua_State* L) noexcept
+		struct member_writer : member_accessor
 		{
 			static_assert(type_traits<_Type>::can_get
 				&& type_traits<_Type>::stack_count == 1, "wrong type for writer.");
-			if (lua_type(L, 1) == LUA_TUSERDATA)
+
+			member_writer(bool(_Der::*f)(_Type)) noexcept : func(f) {}
+
+			virtual int write(lua_State* L, int self, int idx) noexcept
 			{
-				_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, 1),
-					*(class_info_data*)lua_touserdata(L, lua_upvalueindex(1)));
-				if (obj)
+				if (lua_type(L, self) == LUA_TUSERDATA)
 				{
-					if (type_traits<_Type>::test(L, -1))
+					_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, self), *info);
+					if (obj)
 					{
-						auto f = type_traits<bool(_Der::*)(_Type)>::get(L, lua_upvalueindex(2));
-						if ((obj->*f)(type_traits<_Type>::get(L, -1)))
+						if (type_traits<_Type>::test(L, idx))
 						{
-							lua_pushinteger(L, WRITER_SUCCEEDED);
-						}
-						else
-						{
-							lua_pushinteger(L, WRITER_VALUE_FAILED);
+							return (obj->*func)(type_traits<_Type>::get(L, idx))
+								? WRITER_SUCCEEDED : WRITER_VALUE_FAILED;
 						}
+						return WRITER_TYPE_FAILED;
 					}
-					else
+				}
+				return WRITER_UNKNOWN_FIALED;
+			}
+
+			bool(_Der::*func)(_Type);
+		};
+
+		template <class _Ptr>
+		struct member_value;
+
+		template <class _Owner, class _Type>
+		struct member_value<_Type _Owner::*>
+		{
+			typedef _Type type;
+		};
+
+		template <class _Der, class _Ptr, _Ptr _Target>
+		struct bound_member_reader : member_accessor
+		{
+			typedef typename member_value<_Ptr>::type value_type;
+			static_assert(type_traits<value_type>::can_push
+				&& type_traits<value_type>::stack_count == 1, "wrong type for reader.");
+
+			virtual int read(lua_State* L, int self) noexcept
+			{
+				if (lua_type(L, self) == LUA_TUSERDATA)
+				{
+					_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, self), *info);
+					if (obj)
 					{
-						lua_pushinteger(L, WRITER_TYPE_FAILED);
+						return type_traits<value_type>::push(L, obj->*_Target);
 					}
-					return 1;
 				}
+				return 0;
 			}
-			lua_pushinteger(L, WRITER_UNKNOWN_FIALED);
-			return 1;
-		}
+		};
+
+		template <class _Der, class _Ptr, _Ptr _Target>
+		struct bound_member_writer : member_accessor
+		{
+			typedef typename member_value<_Ptr>::type value_type;
+			static_assert(type_traits<value_type>::can_get
+				&& type_traits<value_type>::stack_count == 1, "wrong type for writer.");
+
+			virtual int write(lua_State* L, int self, int idx) noexcept
+			{
+				if (lua_type(L, self) == LUA_TUSERDATA)
+				{
+					_Der* obj = (_Der*)get_adjusted_ptr((header*)lua_touserdata(L, self), *info);
+					if (obj)
+					{
+						if (type_traits<value_type>::test(L, idx))
+						{
+							(obj->*_Target) = type_traits<value_type>::get(L, idx);
+							return WRITER_SUCCEEDED;
+						}
+						return WRITER_TYPE_FAILED;
+					}
+				}
+				return WRITER_UNKNOWN_FIALED;
+			}
+		};
 	}
 
 	template<class _Der, class... _Bases>
@@ -1188,17 +1622,21 @@ namespace luabind
 	{
 		static void find(env& e) noexcept
 		{
-			detail::class_info_data* info = &(detail::class_info<_Der>::info_data_map[e.L]);
-			detail::class_info_data* super_info = &(detail::class_info<_This>::info_data_map[e.L]);
+			detail::class_info_data* info = &(e.get_class<_Der>());
+			detail::class_info_data* super_info = &(e.get_class<_This>());
 			static_assert(std::is_base_of<_This, _Der>::value, "_This need to be a base of _Der.");
 			ptrdiff_t diff = (ptrdiff_t)(void*)static_cast<_This*>(((_Der*)1)) - 1;
-			info->base_map[super_info->type_id] = std::make_pair(diff, super_info);
+			info->base_map[detail::class_info<_This>::index()] = std::make_pair(diff, super_info);
 			for (auto base : super_info->base_map)
 			{
 				info->base_map[base.first] = std::make_pair(
 					base.second.first + diff, base.second.second);
 			}
-			super_info->sub_map[info->type_id] = std::make_pair(diff, super_info);
+			super_info->add_sub(info->type_id, diff);
+			for (auto base : super_info->base_map)
+			{
+				base.second.second->add_sub(info->type_id, base.second.first + diff);
+			}
 			base_finder<_Der, _Rest...>::find(e);
 		}
 	};
@@ -1220,14 +1658,18 @@ namespace luabind
 	{
 		static void fill(lua_State* L) noexcept
 		{
-			detail::class_info_data* super_info = &(detail::class_info<_This>::info_data_map[get_main(L)]);
-			LB_ASSERT(super_info->class_id);
-			lua_rawgeti(L, LUA_REGISTRYINDEX, super_info->class_id);
-			LB_ASSERT_EQ(lua_getmetatable(L, -1), 1);
-			lua_rawgeti(L, -1, INDEX_CLASS);
+			detail::class_info_data* super_info = &get_env(L)->get_class<_This>();
+			detail::materialize(L, super_info);
+			if (super_info->meta_ref)
+			{
+				lua_rawgeti(L, LUA_REGISTRYINDEX, super_info->meta_ref);
+			}
+			else
+			{
+				lua_newtable(L);
+			}
 			LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
-			lua_rawseti(L, -4, idx + 1);
-			lua_pop(L, 2);
+			lua_rawseti(L, -2, idx + 1);
 			base_filler<idx + 1, _Der, _Rest...>::fill(L);
 		}
 	};
@@ -1273,6 +1715,47 @@ namespace luabind
 
 	};
 
+	template <class _Class, class _Func, _Func _Target, class... _Types>
+	struct class_bound_func_def
+	{
+		static _Class& def(_Class& c, const char* name, _Types... pak) noexcept
+		{
+			return c.template def_bound_func<_Func, _Target>(name, pak...);
+		}
+	};
+
+	template <class _Class, class _Val, _Val _Target>
+	struct class_bound_val_def
+	{
+		static_assert(std::is_member_object_pointer<_Val>::value,
+			"_Target has to be a member function or a member variable.");
+
+		static _Class& def(_Class& c, const char* name) noexcept
+		{
+			return c.template def_bound_reader<_Val, _Target>(name)
+				.template def_bound_writer<_Val, _Target>(name);
+		}
+	};
+
+	template <class _Class, class _Val, _Val _Target>
+	struct class_bound_const_def
+	{
+		static _Class& def(_Class& c, const char* name) noexcept
+		{
+			return c.template def_bound_reader<_Val, _Target>(name);
+		}
+	};
+
+	template <class _Class, class _Func, _Func _Target, class... _Types>
+	struct class_bound_def : std::conditional<std::is_member_function_pointer<_Func>::value,
+		class_bound_func_def<_Class, _Func, _Target, _Types...>,
+		typename std::conditional<std::is_const<typename detail::member_value<_Func>::type>::value,
+		class_bound_const_def<_Class, _Func, _Target>,
+		class_bound_val_def<_Class, _Func, _Target>>::type>::type
+	{
+
+	};
+
 	template <class _Class, class _Der, class _Type>
 	struct class_val_def<_Class, _Type _Der::*>
 	{
@@ -1346,22 +1829,12 @@ namespace luabind
 #				endif
 				{
 					lua_pushvalue(L, 2);
-#					if (LUA_VERSION_NUM >= 503)
-					if (lua_rawget(L, -2) == LUA_TFUNCTION)
-#					else
 					lua_rawget(L, -2);
-					if (lua_type(L, -1) == LUA_TFUNCTION)
-#					endif
+					if (detail::is_accessor(L, -1))
 					{
-						lua_pushvalue(L, 3);
-						if (lua_pcall(L, 1, 0, 0))
-						{
-							return luaL_error(L, lua_tostring(L, -1));
-						}
-						else
-						{
-							return 0;
-						}
+						int res = detail::call_writer(L, 0, 3);
+						return detail::writer_error(L,
+							res == detail::WRITER_STATUS_MISSING ? detail::WRITER_STATUS_INVALID : res);
 					}
 				}
 				lua_settop(L, 3);
@@ -1404,49 +1877,115 @@ namespace luabind
 			return 0;
 		}
 
+		struct lazy_enrollment;
+
 		struct enrollment : detail::enrollment
 		{
 			static detail::class_info_data* get_class_info(lua_State* L) noexcept
 			{
 				env& e = *get_env(L);
-				detail::class_info_data* info = &(detail::class_info<_Der>::info_data_map[e.L]);
+				detail::class_info_data* info = &(e.get_class<_Der>());
 				if (!info->type_id)
 				{
-					info->type_id = int(e.class_map.size());
-					e.class_map.push_back(info);
+					info->type_id = detail::class_info<_Der>::index();
+					info->add_sub(info->type_id, 0);
 					info->base_map.clear();
 					base_finder<_Der, _Bases...>::find(e);
 				}
 				return info;
 			}
 
-			enrollment(const char* n) noexcept
-				: name(n)
+			struct members
+			{
+				scope member_scope;
+				scope inner_scope;
+			};
+
+			enrollment(const char* n, int f) noexcept
+				: name(n), flags(f), body(std::make_shared<members>())
+			{
+
+			}
+
+			enrollment(const char* n, int f, const std::shared_ptr<members>& b) noexcept
+				: name(n), flags(f), body(b)
+			{
+
+			}
+
+			static int lazy_gc(lua_State* L) noexcept
+			{
+				delete *(enrollment**)lua_touserdata(L, 1);
+				return 0;
+			}
+
+			static int materialize(lua_State* L) noexcept
 			{
+				env* e = get_env(L);
+				detail::class_info_data* info = e->find_class<_Der>();
+				if (!info || !info->lazy_ref)
+				{
+					return 0;
+				}
+				luaL_unref(L, LUA_REGISTRYINDEX, info->lazy_ref);
+				info->lazy_ref = 0;
+				lua_pushvalue(L, lua_upvalueindex(4));
+				lua_pushnil(L);
+				lua_setmetatable(L, -2);
+				lua_pushvalue(L, lua_upvalueindex(2));
+				lua_pushvalue(L, lua_upvalueindex(3));
+				//A lazy body is enrolled on demand and never belongs to a replay.
+				detail::binding_replay* replay = detail::active_replay();
+				detail::active_replay() = nullptr;
+				(*(enrollment**)lua_touserdata(L, lua_upvalueindex(1)))->enroll(L);
+				detail::active_replay() = replay;
+				lua_pop(L, 3);
+				++e->lazy_materialized;
+				return 0;
+			}
 
+			void enroll_lazy(lua_State* L, detail::class_info_data* info) const noexcept
+			{
+				LUABIND_HOLD_STACK(L);
+				int table = lua_gettop(L);
+				gettable(L, name);
+				int cls = lua_gettop(L);
+				*(enrollment**)lua_newuserdata(L, sizeof(enrollment*))
+					= new lazy_enrollment(name, flags & ~CLASS_LAZY, body);
+				detail::push_gc_meta<&lazy_gc>(L);
+				lua_setmetatable(L, -2);
+				lua_pushvalue(L, table - 1);
+				lua_pushvalue(L, table);
+				lua_pushvalue(L, cls);
+				lua_pushcclosure(L, &materialize, 4);
+				lua_pushvalue(L, -1);
+				info->lazy_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+				detail::set_lazy_meta(L, cls);
+				++get_env(L)->lazy_classes;
 			}
 
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				auto info = get_class_info(L);
+				detail::materialize(L, info);
+				if ((flags & CLASS_LAZY) && !info->meta_ref)
+				{
+					info->flags |= flags;
+					enroll_lazy(L, info);
+					return;
+				}
+				info->flags |= flags;
 				LUABIND_CHECK_STACK(L);
-				char full_name[LB_BUF_SIZE];
+				char buf[LB_BUF_SIZE];
 				lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
 				LB_ASSERT(lua_type(L, -1) == LUA_TSTRING);
-				const char* super_name = lua_tostring(L, -1);
-				if (*super_name)
-				{
-					sprintf(full_name, "%s.%s", super_name, name);
-				}
-				else
-				{
-					sprintf(full_name, "%s", name);
-				}
+				const char* full_name = detail::get_full_name(recorded_name,
+					lua_tostring(L, -1), name, buf);
 				lua_pop(L, 1);
 				gettable(L, name);
 				if (!lua_getmetatable(L, -1))
 				{
-					lua_newtable(L);
+					detail::new_table(L, INDEX_MAX - 1, 4);
 					lua_pushvalue(L, -1);
 					lua_setmetatable(L, -3);
 				}
@@ -1468,7 +2007,7 @@ namespace luabind
 					lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
 					lua_pushcclosure(L, &class_::__tostring, 1);
 					lua_rawset(L, -3);
-					lua_newtable(L);
+					detail::new_table(L);
 					lua_pushstring(L, "__newindex");
 					lua_rawgeti(L, -3, INDEX_SCOPE_NAME);
 					lua_pushcclosure(L, &class_::__newindex, 1);
@@ -1497,7 +2036,7 @@ namespace luabind
 #				endif				
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					detail::new_table(L, OBJ_MAX - 1, 3);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -4, INDEX_CLASS);
 					lua_pushstring(L, "__gc");
@@ -1514,15 +2053,9 @@ namespace luabind
 					lua_pushcclosure(L, &detail::obj_newindex, 1);
 					lua_rawset(L, -3);
 
-					lua_pushcclosure(L, &detail::inherit_index, 0);
-					lua_rawseti(L, -2, OBJ_INDEX);
-
-					lua_pushcclosure(L, &detail::inherit_newindex, 0);
-					lua_rawseti(L, -2, OBJ_NEW_INDEX);
-
 					if (sizeof...(_Bases))
 					{
-						lua_newtable(L);
+						detail::new_table(L, sizeof...(_Bases), 0);
 						base_filler<0, _Der, _Bases...>::fill(L);
 #						if (LUA_VERSION_NUM >= 502)
 						LB_ASSERT(lua_rawlen(L, -1) == sizeof...(_Bases));
@@ -1534,26 +2067,45 @@ namespace luabind
 						lua_rawseti(L, -2, OBJ_SUPER);
 					}
 				}
-				member_scope.enroll(L);
+				if (!info->meta_ref)
+				{
+					lua_pushvalue(L, -1);
+					info->meta_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+				}
+				body->member_scope.enroll(L);
 				lua_pop(L, 1);
-				inner_scope.enroll(L);
+				detail::reflatten(L, *info);
+				body->inner_scope.enroll(L);
 				lua_pop(L, 3);
 			}
 
 			const char* name;
-			scope member_scope;
-			scope inner_scope;
+			int flags;
+			std::shared_ptr<members> body;
+			mutable std::string recorded_name;
+		};
+
+		struct lazy_enrollment : enrollment
+		{
+			lazy_enrollment(const char* n, int f,
+				const std::shared_ptr<typename enrollment::members>& b) noexcept
+				: enrollment(nullptr, f, b), full(n)
+			{
+				enrollment::name = full.c_str();
+			}
+
+			std::string full;
 		};
 
-		explicit class_(const char* name) noexcept
-			: scope(new enrollment(name))
+		explicit class_(const char* name, int flags = CLASS_NORMAL) noexcept
+			: scope(new enrollment(name, flags))
 		{
 
 		}
 
 		class_& operator [] (scope s) noexcept
 		{
-			((enrollment*)chain)->inner_scope.operator,(s);
+			((enrollment*)chain)->body->inner_scope.operator,(s);
 			return *this;
 		}
 
@@ -1568,7 +2120,17 @@ namespace luabind
 		{
 			auto shell = create_func_shell<count_func_params((_Func*)nullptr) - (sizeof...(_Types))>(
 				std::move(func));
-			((enrollment*)chain)->member_scope.operator,
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::construct_func<_Der, decltype(shell), _Types...>(shell, pak...)));
+			return *this;
+		}
+
+		template <class _Func, class... _Types>
+		class_& def_constructor(_Func* func, _Types... pak) noexcept
+		{
+			static_assert(std::is_function<_Func>::value, "_Func has to be a function.");
+			auto shell = create_func_shell<count_func_params((_Func*)nullptr) - (sizeof...(_Types))>(func);
+			((enrollment*)chain)->body->member_scope.operator,
 				(scope(new detail::construct_func<_Der, decltype(shell), _Types...>(shell, pak...)));
 			return *this;
 		}
@@ -1578,7 +2140,17 @@ namespace luabind
 		{
 			auto shell = create_func_shell<count_func_params((_Func*)nullptr) - (sizeof...(_Types))>(
 				std::move(func));
-			((enrollment*)chain)->member_scope.operator,
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::new_func<_Der, decltype(shell), _Types...>(shell, pak...)));
+			return *this;
+		}
+
+		template <class _Func, class... _Types>
+		class_& def_new(_Func* func, _Types... pak) noexcept
+		{
+			static_assert(std::is_function<_Func>::value, "_Func has to be a function.");
+			auto shell = create_func_shell<count_func_params((_Func*)nullptr) - (sizeof...(_Types))>(func);
+			((enrollment*)chain)->body->member_scope.operator,
 				(scope(new detail::new_func<_Der, decltype(shell), _Types...>(shell, pak...)));
 			return *this;
 		}
@@ -1589,15 +2161,41 @@ namespace luabind
 			static_assert(std::is_member_function_pointer<_Func>::value,
 				"func has to be a member function.");
 			auto shell = create_member_func_shell<count_func_params((_Func)nullptr) - (sizeof...(_Types))>(func);
-			((enrollment*)chain)->member_scope.operator,
-				(scope(new detail::member_func<decltype(shell), _Types...>(name, shell, pak...)));
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_func<_Der, decltype(shell), _Types...>(name, shell, pak...)));
+			return *this;
+		}
+
+		template <class _Func, _Func _Target, class... _Types>
+		class_& def(const char* name, _Types... pak) noexcept
+		{
+			return class_bound_def<class_, _Func, _Target, _Types...>::def(*this, name, pak...);
+		}
+
+		template <class _Func, _Func _Target, class... _Types>
+		class_& def_bound_func(const char* name, _Types... pak) noexcept
+		{
+			static_assert(std::is_member_function_pointer<_Func>::value,
+				"_Target has to be a member function.");
+			typedef decltype(create_member_func_shell<count_func_params(_Target) - (sizeof...(_Types))>(
+				_Target)) shell;
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::static_member_func<_Der, shell, _Target, _Types...>(name, pak...)));
 			return *this;
 		}
 
+#		ifdef __cpp_nontype_template_parameter_auto
+		template <auto _Target, class... _Types>
+		class_& def(const char* name, _Types... pak) noexcept
+		{
+			return def<decltype(_Target), _Target>(name, pak...);
+		}
+#		endif
+
 		template <class... _Types>
 		class_& def_manual(const char* name, lua_CFunction func, _Types... pak) noexcept
 		{
-			((enrollment*)chain)->member_scope.operator,
+			((enrollment*)chain)->body->member_scope.operator,
 				(scope(new detail::manual_member_func<_Types...>(name, func, pak...)));
 			return *this;
 		}
@@ -1605,7 +2203,7 @@ namespace luabind
 		template <class... _Types>
 		class_& def_manual_reader(const char* name, lua_CFunction func, _Types... pak) noexcept
 		{
-			((enrollment*)chain)->member_scope.operator,
+			((enrollment*)chain)->body->member_scope.operator,
 				(scope(new detail::manual_member_reader<_Der, _Types...>(name, func, pak...)));
 			return *this;
 		}
@@ -1613,19 +2211,35 @@ namespace luabind
 		template <class _Type>
 		class_& def_readonly(const char* name, _Type _Der::* val) noexcept
 		{
-			return def_manual_reader(name, &detail::value_member_reader<_Der, _Type>, val);
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_accessor_def<_Der, OBJ_READER,
+					detail::value_member_reader<_Der, _Type>>(name, detail::value_member_reader<_Der, _Type>(val))));
+			return *this;
+		}
+
+		template <class _Val, _Val _Target>
+		class_& def_bound_reader(const char* name) noexcept
+		{
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_accessor_def<_Der, OBJ_READER,
+					detail::bound_member_reader<_Der, _Val, _Target>>(name,
+					detail::bound_member_reader<_Der, _Val, _Target>())));
+			return *this;
 		}
 
 		template <class _Type>
 		class_& def_reader(const char* name, _Type(_Der::*func)()) noexcept
 		{
-			return def_manual_reader(name, &detail::member_reader<_Der, _Type>, func);
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_accessor_def<_Der, OBJ_READER,
+					detail::member_reader<_Der, _Type>>(name, detail::member_reader<_Der, _Type>(func))));
+			return *this;
 		}
 
 		template <class... _Types>
 		class_& def_manual_writer(const char* name, lua_CFunction func, _Types... pak) noexcept
 		{
-			((enrollment*)chain)->member_scope.operator,
+			((enrollment*)chain)->body->member_scope.operator,
 				(scope(new detail::manual_member_writer<_Der, _Types...>(name, func, pak...)));
 			return *this;
 		}
@@ -1633,13 +2247,29 @@ namespace luabind
 		template <class _Type>
 		class_& def_writeonly(const char* name, _Type _Der::* val) noexcept
 		{
-			return def_manual_writer(name, &detail::value_member_writer<_Der, _Type>, val);
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_accessor_def<_Der, OBJ_WRITER,
+					detail::value_member_writer<_Der, _Type>>(name, detail::value_member_writer<_Der, _Type>(val))));
+			return *this;
+		}
+
+		template <class _Val, _Val _Target>
+		class_& def_bound_writer(const char* name) noexcept
+		{
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_accessor_def<_Der, OBJ_WRITER,
+					detail::bound_member_writer<_Der, _Val, _Target>>(name,
+					detail::bound_member_writer<_Der, _Val, _Target>())));
+			return *this;
 		}
 
 		template <class _Type>
 		class_& def_writer(const char* name, bool(_Der::*func)(_Type)) noexcept
 		{
-			return def_manual_writer(name, &detail::member_writer<_Der, _Type>, func);
+			((enrollment*)chain)->body->member_scope.operator,
+				(scope(new detail::member_accessor_def<_Der, OBJ_WRITER,
+					detail::member_writer<_Der, _Type>>(name, detail::member_writer<_Der, _Type>(func))));
+			return *this;
 		}
 
 	};
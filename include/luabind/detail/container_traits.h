@@ -0,0 +1,479 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus
+//  File name:   container_traits.h
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <iterator>
+
+namespace luabind
+{
+	namespace detail
+	{
+		inline int abs_index(lua_State* L, int idx) noexcept
+		{
+			return (idx > 0 || idx <= LUA_REGISTRYINDEX) ? idx : lua_gettop(L) + idx + 1;
+		}
+
+		inline size_t table_len(lua_State* L, int idx) noexcept
+		{
+#			if (LUA_VERSION_NUM >= 502)
+			return lua_rawlen(L, idx);
+#			else
+			return lua_objlen(L, idx);
+#			endif
+		}
+
+		template <class _Ty>
+		struct is_number_element : std::integral_constant<bool,
+			std::is_arithmetic<_Ty>::value && !std::is_same<_Ty, bool>::value>
+		{
+
+		};
+
+		template <class _Ty, bool = is_number_element<_Ty>::value>
+		struct element_traits
+		{
+			static bool test(lua_State* L, int t, size_t len) noexcept
+			{
+				for (size_t i = 1; i <= len; ++i)
+				{
+					lua_rawgeti(L, t, (int)i);
+					bool res = type_traits<_Ty>::test(L, -1);
+					lua_pop(L, 1);
+					if (!res) return false;
+				}
+				return true;
+			}
+
+			template <class _Iter>
+			static void get(lua_State* L, int t, _Iter it, size_t len) noexcept
+			{
+				for (size_t i = 1; i <= len; ++i, ++it)
+				{
+					lua_rawgeti(L, t, (int)i);
+					*it = type_traits<_Ty>::get(L, -1);
+					lua_pop(L, 1);
+				}
+			}
+
+			template <class _Iter>
+			static void push(lua_State* L, _Iter it, _Iter end) noexcept
+			{
+				for (int i = 1; it != end; ++it, ++i)
+				{
+					if (type_traits<_Ty>::push(L, *it) != 1)
+					{
+						lua_pushnil(L);
+					}
+					lua_rawseti(L, -2, i);
+				}
+			}
+		};
+
+		template <class _Ty>
+		struct element_traits<_Ty, true>
+		{
+			static bool test(lua_State* L, int t, size_t len) noexcept
+			{
+				for (size_t i = 1; i <= len; ++i)
+				{
+#					if (LUA_VERSION_NUM >= 503)
+					bool res = lua_rawgeti(L, t, (lua_Integer)i) == LUA_TNUMBER;
+#					else
+					lua_rawgeti(L, t, (int)i);
+					bool res = lua_type(L, -1) == LUA_TNUMBER;
+#					endif
+					lua_pop(L, 1);
+					if (!res) return false;
+				}
+				return true;
+			}
+
+			template <class _Iter>
+			static void get(lua_State* L, int t, _Iter it, size_t len) noexcept
+			{
+				for (size_t i = 1; i <= len; ++i, ++it)
+				{
+					lua_rawgeti(L, t, (int)i);
+					*it = number_traits<_Ty>::get(L, -1);
+					lua_pop(L, 1);
+				}
+			}
+
+			template <class _Iter>
+			static void push(lua_State* L, _Iter it, _Iter end) noexcept
+			{
+				for (int i = 1; it != end; ++it, ++i)
+				{
+					number_traits<_Ty>::push(L, *it);
+					lua_rawseti(L, -2, i);
+				}
+			}
+		};
+
+		template <class _Container>
+		struct sequence_filler
+		{
+			typedef typename _Container::value_type value_type;
+
+			static bool check(size_t) noexcept
+			{
+				return true;
+			}
+
+			static void fill(lua_State* L, int t, _Container& c, size_t len) noexcept
+			{
+				fill(L, t, c, len, is_number_element<value_type>());
+			}
+
+			static void fill(lua_State* L, int t, _Container& c, size_t len, std::true_type) noexcept
+			{
+				c.resize(len);
+				element_traits<value_type>::get(L, t, c.begin(), len);
+			}
+
+			static void fill(lua_State* L, int t, _Container& c, size_t len, std::false_type) noexcept
+			{
+				reserve(c, len);
+				element_traits<value_type>::get(L, t, std::back_inserter(c), len);
+			}
+
+			template <class _Ty, class _Alloc>
+			static void reserve(std::vector<_Ty, _Alloc>& c, size_t len) noexcept
+			{
+				c.reserve(len);
+			}
+
+			template <class _Other>
+			static void reserve(_Other&, size_t) noexcept
+			{
+
+			}
+		};
+
+		template <class _Ty, size_t _Size>
+		struct sequence_filler<std::array<_Ty, _Size>>
+		{
+			static bool check(size_t len) noexcept
+			{
+				return len == _Size;
+			}
+
+			static void fill(lua_State* L, int t, std::array<_Ty, _Size>& c, size_t len) noexcept
+			{
+				if (len == _Size)
+				{
+					element_traits<_Ty>::get(L, t, c.begin(), len);
+				}
+			}
+		};
+	}
+
+	//Overload dispatch runs test() on each candidate before get() runs on the
+	//chosen one, so a sequence argument is walked twice: test() stops at the
+	//first element that fails and get() converts without checking again. For
+	//number elements both walks read the slots directly instead of going
+	//through type_traits per element, and vectors are filled in place.
+	template <class _Container>
+	struct sequence_traits
+	{
+		typedef typename _Container::value_type value_type;
+		typedef detail::element_traits<value_type> element;
+
+		static constexpr bool can_get = type_traits<value_type>::can_get
+			&& type_traits<value_type>::stack_count == 1;
+
+		static constexpr bool can_push = type_traits<value_type>::can_push
+			&& type_traits<value_type>::stack_count == 1;
+
+		static constexpr int stack_count = 1;
+
+		static bool test(lua_State* L, int idx) noexcept
+		{
+			if (lua_type(L, idx) != LUA_TTABLE) return false;
+			LUABIND_HOLD_STACK(L);
+			int t = detail::abs_index(L, idx);
+			size_t len = detail::table_len(L, t);
+			return detail::sequence_filler<_Container>::check(len) && element::test(L, t, len);
+		}
+
+		static _Container get(lua_State* L, int idx) noexcept
+		{
+			_Container c = _Container();
+			if (lua_type(L, idx) == LUA_TTABLE)
+			{
+				LUABIND_HOLD_STACK(L);
+				int t = detail::abs_index(L, idx);
+				detail::sequence_filler<_Container>::fill(L, t, c, detail::table_len(L, t));
+			}
+			return c;
+		}
+
+		static int push(lua_State* L, const _Container& val) noexcept
+		{
+			lua_createtable(L, (int)val.size(), 0);
+			element::push(L, val.begin(), val.end());
+			return 1;
+		}
+
+		static _Container make_default() noexcept
+		{
+			return _Container();
+		}
+	};
+
+	template <class _Container>
+	struct const_ref_sequence_traits : sequence_traits<_Container>
+	{
+		static const _Container& make_default() noexcept
+		{
+			static const _Container empty = _Container();
+			return empty;
+		}
+	};
+
+	namespace detail
+	{
+		inline size_t table_count(lua_State* L, int t) noexcept
+		{
+			size_t count = 0;
+			lua_pushnil(L);
+			while (lua_next(L, t))
+			{
+				lua_pop(L, 1);
+				++count;
+			}
+			return count;
+		}
+
+		template <class _Map>
+		void reserve_map(lua_State*, int, _Map&) noexcept
+		{
+
+		}
+
+		template <class _Key, class _Ty, class _Hash, class _Pred, class _Alloc>
+		void reserve_map(lua_State* L, int t, std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>& m) noexcept
+		{
+			m.reserve(table_count(L, t));
+		}
+	}
+
+	template <class _Map>
+	struct associative_traits
+	{
+		typedef typename _Map::key_type key_type;
+		typedef typename _Map::mapped_type mapped_type;
+
+		static constexpr bool can_get = type_traits<key_type>::can_get
+			&& type_traits<key_type>::stack_count == 1
+			&& type_traits<mapped_type>::can_get
+			&& type_traits<mapped_type>::stack_count == 1;
+
+		static constexpr bool can_push = type_traits<key_type>::can_push
+			&& type_traits<key_type>::stack_count == 1
+			&& type_traits<mapped_type>::can_push
+			&& type_traits<mapped_type>::stack_count == 1;
+
+		static constexpr int stack_count = 1;
+
+		static bool test(lua_State* L, int idx) noexcept
+		{
+			if (lua_type(L, idx) != LUA_TTABLE) return false;
+			LUABIND_HOLD_STACK(L);
+			int t = detail::abs_index(L, idx);
+			lua_pushnil(L);
+			while (lua_next(L, t))
+			{
+				if (!type_traits<key_type>::test(L, -2)
+					|| !type_traits<mapped_type>::test(L, -1))
+				{
+					return false;
+				}
+				lua_pop(L, 1);
+			}
+			return true;
+		}
+
+		static _Map get(lua_State* L, int idx) noexcept
+		{
+			_Map m;
+			if (lua_type(L, idx) == LUA_TTABLE)
+			{
+				LUABIND_HOLD_STACK(L);
+				int t = detail::abs_index(L, idx);
+				detail::reserve_map(L, t, m);
+				lua_pushnil(L);
+				while (lua_next(L, t))
+				{
+					m.emplace(type_traits<key_type>::get(L, -2),
+						type_traits<mapped_type>::get(L, -1));
+					lua_pop(L, 1);
+				}
+			}
+			return m;
+		}
+
+		static int push(lua_State* L, const _Map& val) noexcept
+		{
+			lua_createtable(L, 0, (int)val.size());
+			for (auto& kv : val)
+			{
+				if (type_traits<key_type>::push(L, kv.first) != 1)
+				{
+					continue;
+				}
+				if (type_traits<mapped_type>::push(L, kv.second) != 1)
+				{
+					lua_pop(L, 1);
+					continue;
+				}
+				lua_rawset(L, -3);
+			}
+			return 1;
+		}
+
+		static _Map make_default() noexcept
+		{
+			return _Map();
+		}
+	};
+
+	template <class _Map>
+	struct const_ref_associative_traits : associative_traits<_Map>
+	{
+		static const _Map& make_default() noexcept
+		{
+			static const _Map empty;
+			return empty;
+		}
+	};
+
+	template <class _Ty, class _Alloc>
+	struct type_traits<std::vector<_Ty, _Alloc>> : sequence_traits<std::vector<_Ty, _Alloc>>
+	{
+
+	};
+
+	template <class _Ty, class _Alloc>
+	struct type_traits<const std::vector<_Ty, _Alloc>> : sequence_traits<std::vector<_Ty, _Alloc>>
+	{
+
+	};
+
+	template <class _Ty, class _Alloc>
+	struct type_traits<const std::vector<_Ty, _Alloc>&> : const_ref_sequence_traits<std::vector<_Ty, _Alloc>>
+	{
+
+	};
+
+	template <class _Ty, class _Alloc>
+	struct type_traits<std::deque<_Ty, _Alloc>> : sequence_traits<std::deque<_Ty, _Alloc>>
+	{
+
+	};
+
+	template <class _Ty, class _Alloc>
+	struct type_traits<const std::deque<_Ty, _Alloc>> : sequence_traits<std::deque<_Ty, _Alloc>>
+	{
+
+	};
+
+	template <class _Ty, class _Alloc>
+	struct type_traits<const std::deque<_Ty, _Alloc>&> : const_ref_sequence_traits<std::deque<_Ty, _Alloc>>
+	{
+
+	};
+
+	template <class _Ty, size_t _Size>
+	struct type_traits<std::array<_Ty, _Size>> : sequence_traits<std::array<_Ty, _Size>>
+	{
+
+	};
+
+	template <class _Ty, size_t _Size>
+	struct type_traits<const std::array<_Ty, _Size>> : sequence_traits<std::array<_Ty, _Size>>
+	{
+
+	};
+
+	template <class _Ty, size_t _Size>
+	struct type_traits<const std::array<_Ty, _Size>&> : const_ref_sequence_traits<std::array<_Ty, _Size>>
+	{
+
+	};
+
+	template <class _Key, class _Ty, class _Pred, class _Alloc>
+	struct type_traits<std::map<_Key, _Ty, _Pred, _Alloc>>
+		: associative_traits<std::map<_Key, _Ty, _Pred, _Alloc>>
+	{
+
+	};
+
+	template <class _Key, class _Ty, class _Pred, class _Alloc>
+	struct type_traits<const std::map<_Key, _Ty, _Pred, _Alloc>>
+		: associative_traits<std::map<_Key, _Ty, _Pred, _Alloc>>
+	{
+
+	};
+
+	template <class _Key, class _Ty, class _Pred, class _Alloc>
+	struct type_traits<const std::map<_Key, _Ty, _Pred, _Alloc>&>
+		: const_ref_associative_traits<std::map<_Key, _Ty, _Pred, _Alloc>>
+	{
+
+	};
+
+	template <class _Key, class _Ty, class _Hash, class _Pred, class _Alloc>
+	struct type_traits<std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>>
+		: associative_traits<std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>>
+	{
+
+	};
+
+	template <class _Key, class _Ty, class _Hash, class _Pred, class _Alloc>
+	struct type_traits<const std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>>
+		: associative_traits<std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>>
+	{
+
+	};
+
+	template <class _Key, class _Ty, class _Hash, class _Pred, class _Alloc>
+	struct type_traits<const std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>&>
+		: const_ref_associative_traits<std::unordered_map<_Key, _Ty, _Hash, _Pred, _Alloc>>
+	{
+
+	};
+}
@@ -92,7 +92,7 @@ namespace luabind
 			{
 				if (!lua_getmetatable(L, -1))
 				{
-					lua_newtable(L);
+					detail::new_table(L);
 					lua_pushvalue(L, -1);
 					lua_setmetatable(L, -3);
 				}
@@ -114,7 +114,7 @@ namespace luabind
 					lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
 					lua_pushcclosure(L, &__tostring, 1);
 					lua_rawset(L, -3);
-					lua_newtable(L);
+					detail::new_table(L);
 					lua_pushstring(L, "__newindex");
 					lua_rawgeti(L, -3, INDEX_SCOPE_NAME);
 					lua_pushcclosure(L, &__newindex, 1);
@@ -135,18 +135,11 @@ namespace luabind
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				LUABIND_CHECK_STACK(L);
-				char full_name[LB_BUF_SIZE];
+				char buf[LB_BUF_SIZE];
 				lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
 				LB_ASSERT(lua_type(L, -1) == LUA_TSTRING);
-				const char* super_name = lua_tostring(L, -1);
-				if (*super_name)
-				{
-					sprintf(full_name, "%s.%s", super_name, name);
-				}
-				else
-				{
-					sprintf(full_name, "%s", name);
-				}
+				const char* full_name = detail::get_full_name(recorded_name,
+					lua_tostring(L, -1), name, buf);
 				lua_pop(L, 1);
 				gettable(L, name);
 				getmetatable(L, full_name);
@@ -156,6 +149,7 @@ namespace luabind
 
 			const char* name;
 			scope inner_scope;
+			mutable std::string recorded_name;
 		};
 
 		explicit enum_(const char* name) noexcept
@@ -32,6 +32,8 @@
 
 #include <vector>
 #include <unordered_map>
+#include <limits>
+#include <atomic>
 
 namespace luabind
 {
@@ -43,17 +45,49 @@ namespace luabind
 
 			int type_id = 0;
 			int class_id = 0;
+			int meta_ref = 0;
+			int identity_ref = 0;
+			int lazy_ref = 0;
+			int flags = 0;
 			map base_map;
-			map sub_map;
+			std::vector<ptrdiff_t> sub_cast;
+
+			static ptrdiff_t no_cast() noexcept
+			{
+				return std::numeric_limits<ptrdiff_t>::min();
+			}
+
+			void add_sub(int id, ptrdiff_t diff) noexcept
+			{
+				if (size_t(id) >= sub_cast.size())
+				{
+					sub_cast.resize(id + 1, no_cast());
+				}
+				sub_cast[id] = diff;
+			}
+
+			const ptrdiff_t* find_sub(int id) const noexcept
+			{
+				return size_t(id) < sub_cast.size() && sub_cast[id] != no_cast()
+					? &sub_cast[id] : nullptr;
+			}
 		};
 
+		inline int next_class_index() noexcept
+		{
+			static std::atomic<int> counter(0);
+			return ++counter;
+		}
+
 		template<class _Type>
 		struct class_info
 		{
-			static std::unordered_map<lua_State*, class_info_data> info_data_map;
+			static int index() noexcept
+			{
+				static const int i = next_class_index();
+				return i;
+			}
 		};
-
-		template<class _Type> std::unordered_map<lua_State*, class_info_data> class_info<_Type>::info_data_map;
 	}
 
 	enum related_index
@@ -70,12 +104,94 @@ namespace luabind
 		INDEX_MAX
 	};
 
+	//Class indices are process-wide and handed out atomically; everything else in env,
+	//the class map, registry refs and caches, belongs to one lua_State and is only
+	//touched by the thread running it. Only the env life time may cross threads.
 	struct env
 	{
 		lua_State* L = nullptr;
 		std::vector<detail::class_info_data*> class_map;
+		std::vector<size_t> ref_counts;
+		size_t revision = 0;
+		size_t identity_hits = 0;
+		size_t identity_misses = 0;
+		size_t lazy_classes = 0;
+		size_t lazy_materialized = 0;
+
+		virtual ~env() noexcept
+		{
+			for (auto info : class_map)
+			{
+				delete info;
+			}
+			class_map.clear();
+		}
+
+		detail::class_info_data* find_class(size_t i) const noexcept
+		{
+			return i < class_map.size() ? class_map[i] : nullptr;
+		}
+
+		template <class _Type>
+		detail::class_info_data* find_class() const noexcept
+		{
+			return find_class(detail::class_info<typename std::remove_cv<_Type>::type>::index());
+		}
+
+		template <class _Type>
+		detail::class_info_data& get_class() noexcept
+		{
+			size_t i = detail::class_info<typename std::remove_cv<_Type>::type>::index();
+			if (i >= class_map.size())
+			{
+				class_map.resize(i + 1, nullptr);
+			}
+			if (!class_map[i])
+			{
+				class_map[i] = new detail::class_info_data();
+			}
+			return *class_map[i];
+		}
+
+		void touch() noexcept
+		{
+			++revision;
+		}
 
-		virtual ~env() noexcept = default;
+		int ref(lua_State* state) noexcept
+		{
+			int r = luaL_ref(state, LUA_REGISTRYINDEX);
+			if (r > 0)
+			{
+				if (size_t(r) >= ref_counts.size())
+				{
+					ref_counts.resize(r + 1, 0);
+				}
+				ref_counts[r] = 1;
+			}
+			return r;
+		}
+
+		void add_ref(int r) noexcept
+		{
+			if (r > 0)
+			{
+				LB_ASSERT(size_t(r) < ref_counts.size() && ref_counts[r]);
+				++ref_counts[r];
+			}
+		}
+
+		void release_ref(int r) noexcept
+		{
+			if (r > 0)
+			{
+				LB_ASSERT(size_t(r) < ref_counts.size() && ref_counts[r]);
+				if (!--ref_counts[r] && L)
+				{
+					luaL_unref(L, LUA_REGISTRYINDEX, r);
+				}
+			}
+		}
 
 		void inc() noexcept
 		{
@@ -84,8 +200,7 @@ namespace luabind
 
 		void dec() noexcept
 		{
-			--ref_count;
-			if (!ref_count)
+			if (!--ref_count)
 			{
 				delete_this();
 			}
@@ -94,12 +209,12 @@ namespace luabind
 		static int __gc(lua_State* L) noexcept
 		{
 			env* e = *(env**)lua_touserdata(L, 1);
-			for (auto info : e->class_map)
+#			if (LUA_VERSION_NUM >= 503) && LB_ENV_EXTRASPACE
+			if (e->L)
 			{
-				info->type_id = 0;
-				info->class_id = 0;
-				info->base_map.clear();
+				*(env**)lua_getextraspace(e->L) = nullptr;
 			}
+#			endif
 			e->L = nullptr;
 			e->dec();
 			return 0;
@@ -111,35 +226,55 @@ namespace luabind
 			delete this;
 		}
 
-		size_t ref_count = 0;
+		std::atomic<size_t> ref_count{ 0 };
 
 	};
 
-	inline lua_State* get_main(lua_State* L) noexcept;
+	namespace detail
+	{
+		inline void* env_key() noexcept
+		{
+			static char key;
+			return &key;
+		}
+
+#		if (LUA_VERSION_NUM >= 503) && LB_ENV_EXTRASPACE
+		static_assert(LUA_EXTRASPACE >= sizeof(env*), "LUA_EXTRASPACE is too small to hold env.");
+
+		inline env*& extra_env(lua_State* L) noexcept
+		{
+			return *(env**)lua_getextraspace(L);
+		}
+#		endif
+	}
 
 	inline env* get_env(lua_State* L) noexcept
 	{
-#		if (LUA_VERSION_NUM >= 502)
-		L = get_main(L);
+#		if (LUA_VERSION_NUM >= 503) && LB_ENV_EXTRASPACE
+		if (env* cached = detail::extra_env(L))
+		{
+			return cached;
+		}
 #		endif
 		LUABIND_HOLD_STACK(L);
-#		if (LUA_VERSION_NUM >= 502)
-		lua_pushglobaltable(L);
-#		else
-		lua_pushvalue(L, LUA_GLOBALSINDEX);
-#		endif
-		if (lua_getmetatable(L, -1))
+		env* e;
+		lua_pushlightuserdata(L, detail::env_key());
+		lua_rawget(L, LUA_REGISTRYINDEX);
+		if (lua_type(L, -1) == LUA_TUSERDATA)
 		{
-			lua_rawgeti(L, -1, INDEX_MAX);
-			LB_ASSERT(lua_type(L, -1) == LUA_TUSERDATA);
-			return *(env**)lua_touserdata(L, -1);
+			e = *(env**)lua_touserdata(L, -1);
 		}
 		else
 		{
-			lua_newtable(L);										//metatable for global
-			env* e = new env();										//create env
+			e = new env();											//create env
 			e->inc();
+#			if (LUA_VERSION_NUM >= 502)
+			lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+			e->L = lua_tothread(L, -1);
+#			else
 			e->L = L;
+#			endif
+			lua_pushlightuserdata(L, detail::env_key());
 			void* data = lua_newuserdata(L, sizeof(env*));			//create env user data
 			*(env**)data = e;
 			lua_newtable(L);										//create metatable for env user data
@@ -147,15 +282,22 @@ namespace luabind
 			lua_pushcfunction(L, &env::__gc);
 			lua_rawset(L, -3);
 			lua_setmetatable(L, -2);								//set metatable for env user data
-			lua_rawseti(L, -2, INDEX_MAX);							//set env user data to [INDEX_MAX]
-			lua_setmetatable(L, -2);								//set metatable for global
-			return e;
+			lua_rawset(L, LUA_REGISTRYINDEX);						//set env user data to registry[env_key]
+#			if (LUA_VERSION_NUM >= 503) && LB_ENV_EXTRASPACE
+			detail::extra_env(e->L) = e;
+#			endif
 		}
+#		if (LUA_VERSION_NUM >= 503) && LB_ENV_EXTRASPACE
+		detail::extra_env(L) = e;
+#		endif
+		return e;
 	}
 
 	inline lua_State* get_main(lua_State* L) noexcept
 	{
-#		if (LUA_VERSION_NUM >= 502)
+#		if (LUA_VERSION_NUM >= 503) && LB_ENV_EXTRASPACE
+		return get_env(L)->L;
+#		elif (LUA_VERSION_NUM >= 502)
 		LUABIND_HOLD_STACK(L);
 		lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
 		LB_ASSERT(lua_type(L, -1) == LUA_TTHREAD);
@@ -164,4 +306,13 @@ namespace luabind
 		return get_env(L)->L;
 #		endif
 	}
+
+	namespace detail
+	{
+		template <class _Type>
+		class_info_data* find_class_info(lua_State* L) noexcept
+		{
+			return get_env(L)->find_class<_Type>();
+		}
+	}
 }
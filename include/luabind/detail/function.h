@@ -31,56 +31,57 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <cstdint>
+#include <atomic>
 
 namespace luabind
 {
+	namespace detail
+	{
+		inline const char* push_name_owner(lua_State* L, const char* s) noexcept
+		{
+#			if (LUA_VERSION_NUM >= 502)
+			lua_pushglobaltable(L);
+#			else
+			lua_pushvalue(L, LUA_GLOBALSINDEX);
+#			endif
+			const char* end = strchr(s, '.');
+			while (end && lua_type(L, -1) == LUA_TTABLE)
+			{
+				lua_pushlstring(L, s, end - s);
+				lua_gettable(L, -2);
+				lua_remove(L, -2);
+				s = end + 1;
+				end = strchr(s, '.');
+			}
+			return s;
+		}
+	}
+
 	inline int push_func_name(lua_State* L, const char* s) noexcept
 	{
 		if (!s) return 0;
 		int top = lua_gettop(L);
-#		if (LUA_VERSION_NUM >= 502)
-		lua_pushglobaltable(L);
-#		else
-		lua_pushvalue(L, LUA_GLOBALSINDEX);
-#		endif
-		const char* start = s;
-		const char* end = strchr(start, '.');
-		while (start)
+		const char* key = detail::push_name_owner(L, s);
+		if (lua_type(L, -1) == LUA_TTABLE)
 		{
-			if (lua_type(L, -1) != LUA_TTABLE)
-			{
-				lua_pushnil(L);
-				break;
-			}
-			if (end)
-			{
-				lua_pushlstring(L, start, end - start);
-				start = end + 1;
-				end = strchr(start, '.');
-			}
-			else
+			lua_pushstring(L, key);
+			lua_gettable(L, -2);
+			if (lua_type(L, -1) == LUA_TFUNCTION)
 			{
-				lua_pushstring(L, start);
-				start = nullptr;
+				lua_replace(L, top + 1);
+				lua_settop(L, top + 1);
+				return 1;
 			}
-			lua_gettable(L, -2);
-		}
-		if (lua_type(L, -1) == LUA_TFUNCTION)
-		{
-			lua_replace(L, top + 1);
-			lua_settop(L, top + 1);
-			return 1;
-		}
-		else
-		{
-			lua_settop(L, top);
-			return -1;
 		}
+		lua_settop(L, top);
+		return -1;
 	}
 
 	template <class _Ret = void, class... _Types>
 	_Ret call_function(lua_State* L, const char* func,
-		_Types... pak) noexcept
+		_Types&&... pak) noexcept
 	{
 		LUABIND_HOLD_STACK(L);
 		if (push_func_name(L, func) != 1)
@@ -89,7 +90,7 @@ namespace luabind
 			return type_traits<_Ret>::make_default();
 		}
 		LB_ASSERT(lua_type(L, -1) == LUA_TFUNCTION);
-		int num_params = params_pusher<_Types...>::push(L, pak...);
+		int num_params = params_pusher<_Types...>::push(L, std::forward<_Types>(pak)...);
 		if (num_params != params_traits<_Types...>::stack_count)
 		{
 			LB_LOG_W("call function %s without correct params", func);
@@ -112,7 +113,7 @@ namespace luabind
 	}
 
 	template <class _Ret = void, class... _Types>
-	_Ret call_function(object& obj, _Types... pak) noexcept
+	_Ret call_function(object& obj, _Types&&... pak) noexcept
 	{
 		lua_State* L = obj.get_lua();
 		if (!L)
@@ -127,7 +128,7 @@ namespace luabind
 			return type_traits<_Ret>::make_default();
 		}
 		LB_ASSERT(lua_type(L, -1) == LUA_TFUNCTION);
-		int num_params = params_pusher<_Types...>::push(L, pak...);
+		int num_params = params_pusher<_Types...>::push(L, std::forward<_Types>(pak)...);
 		if (num_params != params_traits<_Types...>::stack_count)
 		{
 			LB_LOG_W("call function in object without correct params");
@@ -151,16 +152,236 @@ namespace luabind
 		return type_traits<_Ret>::make_default();
 	}
 
+	template <class _Ret = void, class... _Types>
+	_Ret resume_function(lua_State* co, _Types&&... pak) noexcept
+	{
+		int status = lua_status(co);
+		if (status == LUA_YIELD)
+		{
+			lua_settop(co, 0);
+		}
+		else if (status || lua_type(co, -1) != LUA_TFUNCTION)
+		{
+			LB_LOG_W("coroutine is not resumable");
+			return type_traits<_Ret>::make_default();
+		}
+		int top = lua_gettop(co);
+		int num_params = params_pusher<_Types...>::push(co, std::forward<_Types>(pak)...);
+		if (num_params != params_traits<_Types...>::stack_count)
+		{
+			lua_settop(co, top);
+			LB_LOG_W("resume coroutine without correct params");
+			return type_traits<_Ret>::make_default();
+		}
+#		if (LUA_VERSION_NUM >= 502)
+		status = lua_resume(co, nullptr, num_params);
+#		else
+		status = lua_resume(co, num_params);
+#		endif
+		if (status && status != LUA_YIELD)
+		{
+			LB_LOG_E("%s", lua_tostring(co, -1));
+			return type_traits<_Ret>::make_default();
+		}
+		holder results(co, 0);
+		if (lua_gettop(co) >= type_traits<_Ret>::stack_count
+			&& type_traits<_Ret>::test(co, -type_traits<_Ret>::stack_count))
+		{
+			return type_traits<_Ret>::get(co, -type_traits<_Ret>::stack_count);
+		}
+		else
+		{
+			LB_LOG_E("resume coroutine with wrong return");
+			return type_traits<_Ret>::make_default();
+		}
+	}
+
+	inline void touch_functions(lua_State* L) noexcept
+	{
+		get_env(L)->touch();
+	}
+
+	//function_ref keeps the function it resolved together with the table that
+	//holds it. Each call checks that this table still maps the last name to the
+	//cached function, so reassigning the function from Lua is picked up. A bump
+	//of the env revision (module(), the object setters or touch_functions)
+	//resolves the whole name again, which is needed after an intermediate table
+	//of a dotted name is replaced from plain Lua.
+	template <class _Ret = void>
+	class function_ref
+	{
+	public:
+		function_ref() noexcept = default;
+
+		function_ref(lua_State* L, const char* n) noexcept
+			: parent(get_env(L)), name(n)
+		{
+			parent->inc();
+		}
+
+		function_ref(const function_ref& copy) noexcept
+			: parent(copy.parent), name(copy.name)
+		{
+			if (parent)
+			{
+				parent->inc();
+			}
+		}
+
+		~function_ref() noexcept
+		{
+			clear();
+		}
+
+		function_ref& operator = (const function_ref& copy) noexcept
+		{
+			if (this != &copy)
+			{
+				clear();
+				parent = copy.parent;
+				name = copy.name;
+				if (parent)
+				{
+					parent->inc();
+				}
+			}
+			return *this;
+		}
+
+		const char* get_name() const noexcept
+		{
+			return name.c_str();
+		}
+
+		bool is_valid() noexcept
+		{
+			return prepare() != nullptr;
+		}
+
+		template <class... _Types>
+		_Ret operator () (_Types&&... pak) noexcept
+		{
+			lua_State* L = prepare();
+			if (!L)
+			{
+				LB_LOG_W("%s is not a vaild function", name.c_str());
+				return type_traits<_Ret>::make_default();
+			}
+			LUABIND_HOLD_STACK(L);
+			lua_rawgeti(L, LUA_REGISTRYINDEX, handle);
+			LB_ASSERT(lua_type(L, -1) == LUA_TFUNCTION);
+			int num_params = params_pusher<_Types...>::push(L, std::forward<_Types>(pak)...);
+			if (num_params != params_traits<_Types...>::stack_count)
+			{
+				LB_LOG_W("call function %s without correct params", name.c_str());
+				return type_traits<_Ret>::make_default();
+			}
+			if (lua_pcall(L, num_params, type_traits<_Ret>::stack_count, 0))
+			{
+				LB_LOG_E("%s", lua_tostring(L, -1));
+				return type_traits<_Ret>::make_default();
+			}
+			if (type_traits<_Ret>::test(L, -type_traits<_Ret>::stack_count))
+			{
+				return type_traits<_Ret>::get(L, -type_traits<_Ret>::stack_count);
+			}
+			else
+			{
+				LB_LOG_E("call function %s with wrong return", name.c_str());
+				return type_traits<_Ret>::make_default();
+			}
+		}
+
+	private:
+		lua_State* prepare() noexcept
+		{
+			if (!parent || !parent->L)
+			{
+				return nullptr;
+			}
+			lua_State* L = parent->L;
+			if (handle && revision == parent->revision)
+			{
+				LUABIND_HOLD_STACK(L);
+				lua_rawgeti(L, LUA_REGISTRYINDEX, owner);
+				lua_rawgeti(L, LUA_REGISTRYINDEX, key);
+				lua_gettable(L, -2);
+				lua_rawgeti(L, LUA_REGISTRYINDEX, handle);
+				if (lua_rawequal(L, -1, -2))
+				{
+					return L;
+				}
+			}
+			resolve(L);
+			return handle ? L : nullptr;
+		}
+
+		void resolve(lua_State* L) noexcept
+		{
+			LUABIND_HOLD_STACK(L);
+			release(L);
+			const char* k = detail::push_name_owner(L, name.c_str());
+			if (lua_type(L, -1) == LUA_TTABLE)
+			{
+				lua_pushstring(L, k);
+				lua_pushvalue(L, -1);
+				lua_gettable(L, -3);
+				if (lua_type(L, -1) == LUA_TFUNCTION)
+				{
+					handle = luaL_ref(L, LUA_REGISTRYINDEX);
+					key = luaL_ref(L, LUA_REGISTRYINDEX);
+					owner = luaL_ref(L, LUA_REGISTRYINDEX);
+				}
+			}
+			revision = parent->revision;
+		}
+
+		void release(lua_State* L) noexcept
+		{
+			if (handle)
+			{
+				luaL_unref(L, LUA_REGISTRYINDEX, handle);
+				luaL_unref(L, LUA_REGISTRYINDEX, key);
+				luaL_unref(L, LUA_REGISTRYINDEX, owner);
+				handle = key = owner = 0;
+			}
+		}
+
+		void clear() noexcept
+		{
+			if (parent)
+			{
+				if (parent->L)
+				{
+					release(parent->L);
+				}
+				handle = key = owner = 0;
+				parent->dec();
+				parent = nullptr;
+			}
+		}
+
+		env* parent = nullptr;
+		std::string name;
+		int handle = 0;
+		int key = 0;
+		int owner = 0;
+		size_t revision = 0;
+	};
+
 	template <int idx, class _Ret, class... _Types>
-	struct func_shell
+	struct func_shell_base
 	{
-		typedef std::function<_Ret(_Types...)> func_type;
 		typedef typename params_trimmer<idx, _Types...>::type val_type;
 		typedef _Ret ret_type;
 		typedef std::tuple<_Types...> tuple;
 
 		static constexpr int params_count = sizeof...(_Types);
 		static constexpr int default_start = idx;
+		static constexpr int min_top = params_stack_count<0, idx, _Types...>::value;
+		static constexpr int max_top = params_stack_count<0, params_count, _Types...>::value;
+		static constexpr int construct_min_top = 1 + params_stack_count<1, idx, _Types...>::value;
+		static constexpr int construct_max_top = 1 + params_stack_count<1, params_count, _Types...>::value;
 
 		static bool test(lua_State* L, int top) noexcept
 		{
@@ -171,12 +392,28 @@ namespace luabind
 		{
 			return construct_tester<idx, _Types...>::test(L, top);
 		}
+	};
+
+	template <int idx, class _Ret, class... _Types>
+	struct func_shell : func_shell_base<idx, _Ret, _Types...>
+	{
+		typedef std::function<_Ret(_Types...)> func_type;
 
 		func_shell(func_type&& f) noexcept : func(f) {}
 
 		func_type func;
 	};
 
+	template <int idx, class _Ret, class... _Types>
+	struct func_ptr_shell : func_shell_base<idx, _Ret, _Types...>
+	{
+		typedef _Ret(*func_type)(_Types...);
+
+		func_ptr_shell(func_type f) noexcept : func(f) {}
+
+		func_type func;
+	};
+
 	template <int idx, class _Ret, class... _Types>
 	func_shell<idx, _Ret, _Types...> create_func_shell(
 		std::function<_Ret(_Types...)>&& func) noexcept
@@ -184,8 +421,174 @@ namespace luabind
 		return func_shell<idx, _Ret, _Types...>(std::move(func));
 	}
 
+	template <int idx, class _Ret, class... _Types>
+	func_ptr_shell<idx, _Ret, _Types...> create_func_shell(
+		_Ret(*func)(_Types...)) noexcept
+	{
+		return func_ptr_shell<idx, _Ret, _Types...>(func);
+	}
+
+	namespace detail
+	{
+		//Identifies the bound class and storage of a luabind userdata, or 0 for
+		//any other value. Defined in class.h next to the userdata header.
+		inline uint32_t class_fingerprint(lua_State* L, int idx) noexcept;
+	}
+
+	// The memo maps the lua types of the arguments, plus the class of up to two
+	// bound objects among them, to the only overload of the arity bucket that
+	// accepts them. A key accepted by several overloads is
+	// remembered as shared and always takes the ordered scan, so the first
+	// overload in registration order keeps winning. A hit still runs that
+	// overload's test, and misses are never cached.
+	template <class _Holder>
+	struct overload_set
+	{
+		static constexpr int max_fingerprint_params = 14;
+		static constexpr int max_fingerprint_classes = 2;
+		static constexpr size_t max_memo_size = 64;
+
+		struct memo_key
+		{
+			uint64_t types;
+			uint64_t classes;
+
+			bool operator == (const memo_key& k) const noexcept
+			{
+				return types == k.types && classes == k.classes;
+			}
+		};
+
+		struct memo_hash
+		{
+			size_t operator () (const memo_key& k) const noexcept
+			{
+				return std::hash<uint64_t>()(k.types ^ (k.classes * 0x9e3779b97f4a7c15ull));
+			}
+		};
+
+		void reset() noexcept
+		{
+			arity.clear();
+			memo.clear();
+		}
+
+		_Holder* find(_Holder* head, lua_State* L, int top) noexcept
+		{
+			memo_key key = fingerprint(L, top, head->base);
+			bool shared = false;
+			if (key.types)
+			{
+				auto it = memo.find(key);
+				if (it != memo.end())
+				{
+					if (it->second && it->second->test(L, top))
+					{
+						return it->second;
+					}
+					shared = !it->second;
+				}
+			}
+			if (arity.empty())
+			{
+				build(head);
+			}
+			if (size_t(top) >= arity.size())
+			{
+				return nullptr;
+			}
+			_Holder* res = nullptr;
+			int accepted = 0;
+			for (auto h : arity[top])
+			{
+				if (h->test(L, top))
+				{
+					if (!res)
+					{
+						res = h;
+					}
+					if (!key.types || shared || ++accepted > 1)
+					{
+						break;
+					}
+				}
+			}
+			if (key.types && res && !shared)
+			{
+				if (memo.size() >= max_memo_size)
+				{
+					memo.clear();
+				}
+				memo[key] = accepted == 1 ? res : nullptr;
+			}
+			return res;
+		}
+
+		void build(_Holder* head) noexcept
+		{
+			int max_top = 0;
+			for (_Holder* h = head; h; h = h->next)
+			{
+				max_top = h->max_top > max_top ? h->max_top : max_top;
+			}
+			arity.resize(max_top + 1);
+			for (_Holder* h = head; h; h = h->next)
+			{
+				for (int i = h->min_top; i <= h->max_top; ++i)
+				{
+					arity[i].push_back(h);
+				}
+			}
+		}
+
+		static memo_key fingerprint(lua_State* L, int top, int base) noexcept
+		{
+			memo_key key = { 0, 0 };
+			if (top - base > max_fingerprint_params)
+			{
+				return key;
+			}
+			uint64_t types = uint64_t(top + 1);
+			int classes = 0;
+			for (int i = base + 1; i <= top; ++i)
+			{
+				int t = lua_type(L, i);
+				switch (t)
+				{
+				case LUA_TNIL:
+				case LUA_TBOOLEAN:
+				case LUA_TLIGHTUSERDATA:
+				case LUA_TNUMBER:
+				case LUA_TSTRING:
+					break;
+				case LUA_TUSERDATA:
+					{
+						uint32_t cls = detail::class_fingerprint(L, i);
+						if (!cls || classes == max_fingerprint_classes)
+						{
+							return key;
+						}
+						key.classes |= uint64_t(cls) << (32 * classes++);
+					}
+					break;
+				default:
+					return key;
+				}
+				types |= uint64_t(t + 1) << (8 + 4 * (i - base - 1));
+			}
+			key.types = types;
+			return key;
+		}
+
+		std::vector<std::vector<_Holder*>> arity;
+		std::unordered_map<memo_key, _Holder*, memo_hash> memo;
+	};
+
 	struct func_holder
 	{
+		func_holder(int min, int max, int b = 0) noexcept
+			: origin(this), min_top(min), max_top(max), base(b) {}
+
 		virtual ~func_holder() noexcept
 		{
 			if (next)
@@ -195,7 +598,41 @@ namespace luabind
 			}
 		}
 
-		virtual int call(lua_State* L) noexcept = 0;
+		virtual bool test(lua_State* L, int top) noexcept = 0;
+
+		virtual int invoke(lua_State* L, int top) noexcept = 0;
+
+		int call(lua_State* L) noexcept
+		{
+			int top = lua_gettop(L);
+			func_holder* h = next ? overloads.find(this, L, top)
+				: (test(L, top) ? this : nullptr);
+			return h ? h->invoke(L, top) : -1;
+		}
+
+		void append(func_holder* h) noexcept
+		{
+			func_holder* tail = this;
+			while (tail->next)
+			{
+				tail = tail->next;
+			}
+			tail->next = h;
+			overloads.reset();
+		}
+
+		void retain() noexcept
+		{
+			++refs;
+		}
+
+		void release() noexcept
+		{
+			if (!--refs)
+			{
+				delete this;
+			}
+		}
 
 		static int __gc(lua_State* L) noexcept
 		{
@@ -216,11 +653,54 @@ namespace luabind
 			}
 			else
 			{
-				return ret;
+				return detail::return_or_yield(L, ret);
 			}
 		}
 
 		func_holder* next = nullptr;
+		func_holder* origin;
+		int min_top;
+		int max_top;
+		int base;
+		std::atomic<size_t> refs{ 1 };
+		overload_set<func_holder> overloads;
+	};
+
+	//A binding_set records each holder once and the states it is replayed into
+	//share it read-only. Every state chains and memoizes overloads through its
+	//own shared_func_holder, which lives in the holder userdata when it heads
+	//the chain.
+	struct shared_func_holder : func_holder
+	{
+		shared_func_holder(func_holder* t) noexcept
+			: func_holder(t->min_top, t->max_top, t->base), target(t)
+		{
+			origin = t->origin;
+			t->retain();
+		}
+
+		virtual ~shared_func_holder() noexcept
+		{
+			target->release();
+		}
+
+		virtual bool test(lua_State* L, int top) noexcept
+		{
+			return target->test(L, top);
+		}
+
+		virtual int invoke(lua_State* L, int top) noexcept
+		{
+			return target->invoke(L, top);
+		}
+
+		static int __gc(lua_State* L) noexcept
+		{
+			(*(func_holder**)lua_touserdata(L, 1))->~func_holder();
+			return 0;
+		}
+
+		func_holder* target;
 	};
 
 	template <class _Shell>
@@ -229,9 +709,12 @@ namespace luabind
 		static int invoke(typename _Shell::func_type& func, typename _Shell::val_type& vals,
 			lua_State* L, int top) noexcept
 		{
-			return type_traits<typename _Shell::ret_type>::push(L,
-				func_invoker<0, _Shell::default_start, _Shell>::invoke(
-					func, vals, L, top));
+			return result_pusher<typename _Shell::ret_type>::push(L,
+				[&]() -> typename _Shell::ret_type
+				{
+					return func_invoker<0, _Shell::default_start, _Shell>::invoke(
+						func, vals, L, top);
+				});
 		}
 	};
 
@@ -260,26 +743,89 @@ namespace luabind
 		typedef typename _Shell::val_type val_type;
 
 		func_holder_impl(const func_type& f, const val_type& v) noexcept
-			: func(f), vals(v) {}
+			: func_holder(_Shell::min_top, _Shell::max_top), func(f), vals(v) {}
+
+		virtual bool test(lua_State* L, int top) noexcept
+		{
+			return _Shell::test(L, top);
+		}
+
+		virtual int invoke(lua_State* L, int top) noexcept
+		{
+			return do_invoke<_Shell>::invoke(func, vals, L, top);
+		}
+
+		func_type func;
+		val_type vals;
+	};
+
+	// A compile-time binding without default values is enrolled holder-less: its
+	// slot keeps a pointer to this descriptor and the holder is only created
+	// when the name gets overloaded.
+	template <class _Holder>
+	struct static_holder_desc
+	{
+		_Holder* (*create)();
+	};
+
+	template <class _Shell, typename _Shell::func_type _Target>
+	struct static_func_holder : func_holder
+	{
+		typedef typename _Shell::func_type func_type;
+		typedef typename _Shell::val_type val_type;
+
+		static_func_holder(const val_type& v) noexcept
+			: func_holder(_Shell::min_top, _Shell::max_top), vals(v) {}
+
+		virtual bool test(lua_State* L, int top) noexcept
+		{
+			return _Shell::test(L, top);
+		}
+
+		virtual int invoke(lua_State* L, int top) noexcept
+		{
+			func_type func = _Target;
+			return do_invoke<_Shell>::invoke(func, vals, L, top);
+		}
 
-		virtual int call(lua_State* L) noexcept
+		static int entry(lua_State* L) noexcept
 		{
 			int top = lua_gettop(L);
 			if (_Shell::test(L, top))
 			{
-				return do_invoke<_Shell>::invoke(func, vals, L, top);
-			}
-			else if (next)
-			{
-				return next->call(L);
-			}
-			else
-			{
-				return -1;
+				func_type func = _Target;
+				return detail::return_or_yield(L, do_invoke<_Shell>::invoke(func,
+					get_vals(L, std::integral_constant<bool,
+					(std::tuple_size<val_type>::value > 0)>()), L, top));
 			}
+			return luaL_error(L, "call c++ function[%s.%s] with wrong params.",
+				lua_tostring(L, lua_upvalueindex(2)),
+				lua_tostring(L, lua_upvalueindex(3)));
+		}
+
+		static val_type& get_vals(lua_State* L, std::true_type) noexcept
+		{
+			return ((static_func_holder*)(*(func_holder**)lua_touserdata(
+				L, lua_upvalueindex(1)))->origin)->vals;
+		}
+
+		static val_type& get_vals(lua_State* L, std::false_type) noexcept
+		{
+			static val_type none;
+			return none;
+		}
+
+		static func_holder* create()
+		{
+			return new static_func_holder(val_type());
+		}
+
+		static const static_holder_desc<func_holder>* desc() noexcept
+		{
+			static const static_holder_desc<func_holder> d = { &create };
+			return &d;
 		}
 
-		func_type func;
 		val_type vals;
 	};
 }
@@ -32,6 +32,67 @@
 
 namespace luabind
 {
+	template <class _Ty>
+	struct default_value
+	{
+		typedef typename std::conditional<std::is_lvalue_reference<_Ty>::value
+			&& std::is_const<typename std::remove_reference<_Ty>::type>::value,
+			typename std::remove_cv<typename std::remove_reference<_Ty>::type>::type,
+			_Ty>::type type;
+	};
+
+	template <class _Ty>
+	struct default_arg
+	{
+		typedef typename std::conditional<std::is_lvalue_reference<_Ty>::value,
+			_Ty, typename std::decay<_Ty>::type>::type type;
+	};
+
+	template <class _Ty>
+	struct result_pusher
+	{
+		template <class _Gen>
+		static int push(lua_State* L, _Gen&& gen) noexcept
+		{
+			return push(L, gen, 0);
+		}
+
+	private:
+		template <class _Gen, class _Traits = type_traits<_Ty>>
+		static auto push(lua_State* L, _Gen& gen, int) noexcept
+			-> decltype(_Traits::emplace(L, gen))
+		{
+			return _Traits::emplace(L, gen);
+		}
+
+		template <class _Gen>
+		static int push(lua_State* L, _Gen& gen, long) noexcept
+		{
+			return type_traits<_Ty>::push(L, gen());
+		}
+	};
+
+	namespace detail
+	{
+		constexpr int yield_mark = 0x40000000;
+
+		inline int return_or_yield(lua_State* L, int ret) noexcept
+		{
+			return (ret & yield_mark) ? lua_yield(L, ret & ~yield_mark) : ret;
+		}
+	}
+
+	template <class... _Types>
+	struct result_pusher<yield_result<_Types...>>
+	{
+		template <class _Gen>
+		static int push(lua_State* L, _Gen&& gen) noexcept
+		{
+			int ret = type_traits<yield_result<_Types...>>::push(L, gen());
+			return ret < 0 ? ret : (ret | detail::yield_mark);
+		}
+	};
+
 	template <int idx, class... _Types>
 	struct params_trimmer;
 
@@ -46,8 +107,39 @@ namespace luabind
 	{
 		typedef typename std::conditional < (idx > 0),
 			typename params_trimmer<idx - 1, _Rest...>::type,
-			typename std::tuple < _This, _Rest... >> ::type type;
+			typename std::tuple < typename default_value<_This>::type,
+			typename default_value<_Rest>::type... >> ::type type;
+	};
+
+	template <int first, int last, class... _Types>
+	struct params_stack_count;
+
+	template <int first, int last>
+	struct params_stack_count<first, last>
+	{
+		static constexpr int value = 0;
+	};
+
+	template <int first, int last, class _This, class... _Rest>
+	struct params_stack_count<first, last, _This, _Rest...>
+	{
+		static constexpr int value = ((first <= 0 && last > 0) ? type_traits<_This>::stack_count : 0)
+			+ params_stack_count<first - 1, last - 1, _Rest...>::value;
+	};
+
+	template <class _Func>
+	struct func_signature
+	{
+		typedef _Func type;
+	};
+
+#	ifdef __cpp_noexcept_function_type
+	template <class _Ret, class... _Types>
+	struct func_signature<_Ret(_Types...) noexcept>
+	{
+		typedef _Ret type(_Types...);
 	};
+#	endif
 
 	template <class _Ret, class... _Types>
 	constexpr int count_func_params(_Ret(*)(_Types...)) noexcept
@@ -135,20 +227,20 @@ namespace luabind
 		typedef typename std::tuple_element<(sizeof...(_Types)), typename _Shell::tuple>::type type;
 
 		static typename _Shell::ret_type invoke(typename _Shell::func_type& f,
-			typename _Shell::val_type& v, lua_State* L, int top, _Types... pak) noexcept
+			typename _Shell::val_type& v, lua_State* L, int top, _Types&&... pak) noexcept
 		{
 			if (top > base)
 			{
 				LB_ASSERT((base + type_traits<type>::stack_count) <= top);
 				return func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						f, v, L, top, pak..., type_traits<type>::get(L, base + 1));
+						f, v, L, top, std::forward<_Types>(pak)..., type_traits<type>::get(L, base + 1));
 			}
 			else
 			{
 				return func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						f, v, L, top, pak..., type_traits<type>::make_default());
+						f, v, L, top, std::forward<_Types>(pak)..., type_traits<type>::make_default());
 			}
 		}
 	};
@@ -159,20 +251,21 @@ namespace luabind
 		typedef typename std::tuple_element<(sizeof...(_Types)), typename _Shell::tuple>::type type;
 
 		static typename _Shell::ret_type invoke(typename _Shell::func_type& f,
-			typename _Shell::val_type& v, lua_State* L, int top, _Types... pak) noexcept
+			typename _Shell::val_type& v, lua_State* L, int top, _Types&&... pak) noexcept
 		{
 			if (top > base)
 			{
 				LB_ASSERT((base + type_traits<type>::stack_count) <= top);
 				return func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						f, v, L, top, pak..., type_traits<type>::get(L, base + 1));
+						f, v, L, top, std::forward<_Types>(pak)..., type_traits<type>::get(L, base + 1));
 			}
 			else
 			{
 				return func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						f, v, L, top, pak..., std::get<sizeof...(_Types)-idx>(v));
+						f, v, L, top, std::forward<_Types>(pak)...,
+						static_cast<typename default_arg<type>::type>(std::get<sizeof...(_Types)-idx>(v)));
 			}
 		}
 	};
@@ -181,9 +274,9 @@ namespace luabind
 	struct func_caller
 	{
 		static typename _Shell::ret_type invoke(typename _Shell::func_type& f,
-			typename _Shell::val_type& v, lua_State* L, int top, _Types... pak) noexcept
+			typename _Shell::val_type& v, lua_State* L, int top, _Types&&... pak) noexcept
 		{
-			return f(pak...);
+			return f(std::forward<_Types>(pak)...);
 		}
 	};
 
@@ -213,20 +306,20 @@ namespace luabind
 
 		static typename _Shell::ret_type invoke(typename _Shell::_Class* o,
 			typename _Shell::func_type f, typename _Shell::val_type& v,
-			lua_State* L, int top, _Types... pak) noexcept
+			lua_State* L, int top, _Types&&... pak) noexcept
 		{
 			if (top > base)
 			{
 				LB_ASSERT((base + type_traits<type>::stack_count) <= top);
 				return member_func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						o, f, v, L, top, pak..., type_traits<type>::get(L, base + 1));
+						o, f, v, L, top, std::forward<_Types>(pak)..., type_traits<type>::get(L, base + 1));
 			}
 			else
 			{
 				return member_func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						o, f, v, L, top, pak..., type_traits<type>::make_default());
+						o, f, v, L, top, std::forward<_Types>(pak)..., type_traits<type>::make_default());
 			}
 		}
 	};
@@ -238,20 +331,21 @@ namespace luabind
 
 		static typename _Shell::ret_type invoke(typename _Shell::_Class* o,
 			typename _Shell::func_type f, typename _Shell::val_type& v,
-			lua_State* L, int top, _Types... pak) noexcept
+			lua_State* L, int top, _Types&&... pak) noexcept
 		{
 			if (top > base)
 			{
 				LB_ASSERT((base + type_traits<type>::stack_count) <= top);
 				return member_func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						o, f, v, L, top, pak..., type_traits<type>::get(L, base + 1));
+						o, f, v, L, top, std::forward<_Types>(pak)..., type_traits<type>::get(L, base + 1));
 			}
 			else
 			{
 				return member_func_invoker<base + type_traits<type>::stack_count,
 					_Shell::default_start, _Shell, _Types..., type>::invoke(
-						o, f, v, L, top, pak..., std::get<sizeof...(_Types)-idx>(v));
+						o, f, v, L, top, std::forward<_Types>(pak)...,
+						static_cast<typename default_arg<type>::type>(std::get<sizeof...(_Types)-idx>(v)));
 			}
 		}
 	};
@@ -261,9 +355,9 @@ namespace luabind
 	{
 		static typename _Shell::ret_type invoke(typename _Shell::_Class* o,
 			typename _Shell::func_type f, typename _Shell::val_type& v,
-			lua_State* L, int top, _Types... pak) noexcept
+			lua_State* L, int top, _Types&&... pak) noexcept
 		{
-			return (o->*f)(pak...);
+			return (o->*f)(std::forward<_Types>(pak)...);
 		}
 	};
 
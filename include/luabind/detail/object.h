@@ -34,6 +34,8 @@
 
 namespace luabind
 {
+	class object_view;
+
 	class object
 	{
 	public:
@@ -99,6 +101,8 @@ namespace luabind
 			return handle;
 		}
 
+		object_view view(lua_State* L) const noexcept;
+
 		void replace(lua_State* L, int idx) noexcept
 		{
 			clear();
@@ -106,38 +110,38 @@ namespace luabind
 			parent->inc();
 			if (parent->L)
 			{
-				LUABIND_HOLD_STACK(parent->L);
-				lua_pushvalue(parent->L, idx);
-				if (lua_type(parent->L, -1) == LUA_TNONE)
+				LUABIND_HOLD_STACK(L);
+				lua_pushvalue(L, idx);
+				if (lua_type(L, -1) == LUA_TNONE)
 				{
 					handle = 0;
 				}
 				else
 				{
-					handle = luaL_ref(parent->L, LUA_REGISTRYINDEX);
+					handle = parent->ref(L);
 				}
 			}
 		}
 
 		void replace(const object& copy) noexcept
 		{
+			if (this == &copy) return;
 			clear();
 			parent = copy.parent;
-			parent->inc();
-			if (parent->L && copy.handle)
-			{
-				LUABIND_HOLD_STACK(parent->L);
-				lua_rawgeti(parent->L, LUA_REGISTRYINDEX, copy.handle);
-				handle = luaL_ref(parent->L, LUA_REGISTRYINDEX);
-			}
-			else
+			if (parent)
 			{
-				handle = 0;
+				parent->inc();
+				if (parent->L && copy.handle)
+				{
+					handle = copy.handle;
+					parent->add_ref(handle);
+				}
 			}
 		}
 
 		void replace(object&& move) noexcept
 		{
+			if (this == &move) return;
 			clear();
 			parent = move.parent;
 			handle = move.handle;
@@ -152,6 +156,7 @@ namespace luabind
 				"_Ty has to occupy 1 stack");
 			clear();
 			parent = get_env(L);
+			parent->inc();
 			if (parent->L)
 			{
 				LUABIND_HOLD_STACK(L);
@@ -163,7 +168,7 @@ namespace luabind
 				else
 				{
 					LB_ASSERT(n == 1);
-					handle = luaL_ref(parent->L, LUA_REGISTRYINDEX);
+					handle = parent->ref(L);
 				}
 			}
 		}
@@ -210,9 +215,9 @@ namespace luabind
 		{
 			if (handle)
 			{
-				if (parent && parent->L)
+				if (parent)
 				{
-					luaL_unref(parent->L, LUA_REGISTRYINDEX, handle);
+					parent->release_ref(handle);
 				}
 				handle = 0;
 			}
@@ -260,6 +265,7 @@ namespace luabind
 					if (type_traits<_Val>::push(parent->L, val) == 1)
 					{
 						lua_settable(parent->L, -3);
+						parent->touch();
 					}
 				}
 			}
@@ -327,7 +333,7 @@ namespace luabind
 			return type_traits<_Ty>::make_default();
 		}
 
-		void rawset(const char* key, object obj) noexcept
+		void rawset(const char* key, const object& obj) noexcept
 		{
 			if (is_table())
 			{
@@ -337,11 +343,12 @@ namespace luabind
 				if (obj.push(parent->L) == 1)
 				{
 					lua_rawset(parent->L, -3);
+					parent->touch();
 				}
 			}
 		}
 
-		void rawseti(int key, object obj) noexcept
+		void rawseti(int key, const object& obj) noexcept
 		{
 			if (is_table())
 			{
@@ -367,6 +374,7 @@ namespace luabind
 				if (type_traits<_Ty>::push(parent->L, val) == 1)
 				{
 					lua_rawset(parent->L, -3);
+					parent->touch();
 				}
 			}
 		}
@@ -401,7 +409,7 @@ namespace luabind
 			return object();
 		}
 
-		void setmetatable(object obj) noexcept
+		void setmetatable(const object& obj) noexcept
 		{
 			switch (get_type())
 			{
@@ -471,6 +479,134 @@ namespace luabind
 		int handle = 0;
 	};
 
+	//An object_view returned by object::view or object_view::operator [] lives
+	//in the stack slot pushed for it and stays valid until the caller pops it.
+	class object_view
+	{
+	public:
+		object_view() noexcept = default;
+
+		object_view(lua_State* state, int idx) noexcept
+			: L(state), index((idx > 0 || idx <= LUA_REGISTRYINDEX) ? idx : lua_gettop(state) + idx + 1) {}
+
+		lua_State* get_lua() const noexcept
+		{
+			return L;
+		}
+
+		int get_index() const noexcept
+		{
+			return index;
+		}
+
+		int push(lua_State* state) const noexcept
+		{
+			if (!L) return 0;
+			LB_ASSERT(state == L);
+			lua_pushvalue(state, index);
+			return 1;
+		}
+
+		int get_type() const noexcept
+		{
+			return L ? lua_type(L, index) : LUA_TNONE;
+		}
+
+		bool is_table() const noexcept
+		{
+			return get_type() == LUA_TTABLE;
+		}
+
+		object to_object() const noexcept
+		{
+			return L ? object(L, index) : object();
+		}
+
+		template <class _Ty>
+		_Ty get() const noexcept
+		{
+			static_assert(type_traits<_Ty>::stack_count == 1,
+				"_Ty has to occupy 1 stack");
+			if (L && type_traits<_Ty>::test(L, index))
+			{
+				return type_traits<_Ty>::get(L, index);
+			}
+			return type_traits<_Ty>::make_default();
+		}
+
+		template <class _Ty>
+		operator _Ty () const noexcept
+		{
+			return get<_Ty>();
+		}
+
+		template <class _Val, class _Key>
+		_Val gettable(_Key key) const noexcept
+		{
+			static_assert(type_traits<_Val>::stack_count == 1
+				&& type_traits<_Key>::stack_count == 1,
+				"_Val and _Key have to occupy 1 stack");
+			if (is_table())
+			{
+				LUABIND_HOLD_STACK(L);
+				if (type_traits<_Key>::push(L, key) == 1)
+				{
+					lua_gettable(L, index);
+					if (type_traits<_Val>::test(L, -1))
+					{
+						return type_traits<_Val>::get(L, -1);
+					}
+				}
+			}
+			return type_traits<_Val>::make_default();
+		}
+
+		object_view operator [] (const char* key) const noexcept
+		{
+			if (!L) return object_view();
+			luaL_checkstack(L, 1, "too many object views");
+			if (is_table())
+			{
+				lua_getfield(L, index, key);
+			}
+			else
+			{
+				lua_pushnil(L);
+			}
+			return object_view(L, lua_gettop(L));
+		}
+
+		object_view operator [] (int key) const noexcept
+		{
+			if (!L) return object_view();
+			luaL_checkstack(L, 1, "too many object views");
+			if (is_table())
+			{
+				lua_pushinteger(L, key);
+				lua_gettable(L, index);
+			}
+			else
+			{
+				lua_pushnil(L);
+			}
+			return object_view(L, lua_gettop(L));
+		}
+
+	private:
+		lua_State* L = nullptr;
+		int index = 0;
+	};
+
+	inline object_view object::view(lua_State* L) const noexcept
+	{
+		luaL_checkstack(L, 1, "too many object views");
+		if (push(L) != 1)
+		{
+			lua_pushnil(L);
+		}
+		return object_view(L, lua_gettop(L));
+	}
+
 	template <>
 	struct type_traits<object>
 	{
@@ -490,7 +626,7 @@ namespace luabind
 			return object(L, idx);
 		}
 
-		static int push(lua_State* L, object val) noexcept
+		static int push(lua_State* L, const object& val) noexcept
 		{
 			return val.push(L);
 		}
@@ -501,6 +637,36 @@ namespace luabind
 		}
 	};
 
+	template <>
+	struct type_traits<object_view>
+	{
+		static constexpr bool can_get = true;
+
+		static constexpr bool can_push = true;
+
+		static constexpr int stack_count = 1;
+
+		static bool test(lua_State* L, int idx) noexcept
+		{
+			return (lua_type(L, idx) != LUA_TNONE);
+		}
+
+		static object_view get(lua_State* L, int idx) noexcept
+		{
+			return object_view(L, idx);
+		}
+
+		static int push(lua_State* L, const object_view& val) noexcept
+		{
+			return val.push(L);
+		}
+
+		static object_view make_default() noexcept
+		{
+			return object_view();
+		}
+	};
+
 	inline object newtable(lua_State* L) noexcept
 	{
 		LUABIND_HOLD_STACK(L);
@@ -34,6 +34,17 @@ namespace luabind
 {
 	namespace detail
 	{
+		template <class _Ty>
+		bool test_sub_obj(lua_State* L, const header* info) noexcept
+		{
+			if (info->type_id == class_info<typename std::remove_cv<_Ty>::type>::index())
+			{
+				return true;
+			}
+			auto data = find_class_info<_Ty>(L);
+			return data && data->find_sub(info->type_id);
+		}
+
 		template <class _Ty>
 		bool test_obj(lua_State* L, int idx) noexcept
 		{
@@ -42,15 +53,7 @@ namespace luabind
 				detail::header* info = (detail::header*)lua_touserdata(L, idx);
 				if (info->type == USERDATA_CLASS)
 				{
-					auto it = detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.find(get_main(L));
-					if (it != detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.end())
-					{
-						if (info->type_id == it->second.type_id
-							|| (it->second.sub_map.find(info->type_id) != it->second.sub_map.end()))
-						{
-							return true;
-						}
-					}
+					return test_sub_obj<_Ty>(L, info);
 				}
 			}
 			return false;
@@ -64,14 +67,7 @@ namespace luabind
 				detail::header* info = (detail::header*)lua_touserdata(L, idx);
 				if (info->type == USERDATA_CLASS && info->storage == s)
 				{
-					auto it = detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.find(get_main(L));
-					if (it != detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.end())
-					{
-						if (info->type_id == it->second.type_id)
-						{
-							return true;
-						}
-					}
+					return info->type_id == class_info<typename std::remove_cv<_Ty>::type>::index();
 				}
 			}
 			return false;
@@ -85,15 +81,7 @@ namespace luabind
 				detail::header* info = (detail::header*)lua_touserdata(L, idx);
 				if (info->type == USERDATA_CLASS && info->storage == STORAGE_I_PTR)
 				{
-					auto it = detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.find(get_main(L));
-					if (it != detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.end())
-					{
-						if (info->type_id == it->second.type_id
-							|| (it->second.sub_map.find(info->type_id) != it->second.sub_map.end()))
-						{
-							return true;
-						}
-					}
+					return test_sub_obj<_Ty>(L, info);
 				}
 			}
 			return false;
@@ -108,14 +96,7 @@ namespace luabind
 				if (info->type == USERDATA_CLASS
 					&& (info->storage == STORAGE_S_PTR || info->storage == STORAGE_W_PTR))
 				{
-					auto it = detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.find(get_main(L));
-					if (it != detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.end())
-					{
-						if (info->type_id == it->second.type_id)
-						{
-							return true;
-						}
-					}
+					return info->type_id == class_info<typename std::remove_cv<_Ty>::type>::index();
 				}
 			}
 			return false;
@@ -124,32 +105,164 @@ namespace luabind
 		template <class _Ty>
 		_Ty* get_obj(lua_State* L, int idx) noexcept
 		{
-			auto it = detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.find(get_main(L));
-			if (it != detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map.end())
+			auto data = (detail::header*)lua_touserdata(L, idx);
+			if (data->type_id == class_info<typename std::remove_cv<_Ty>::type>::index())
 			{
-				return (_Ty*)get_adjusted_ptr((detail::header*)lua_touserdata(L, idx), it->second);
+				return (_Ty*)get_origin_ptr(data);
 			}
-			return nullptr;
+			auto info = find_class_info<_Ty>(L);
+			return info ? (_Ty*)get_adjusted_ptr(data, *info) : nullptr;
 		}
 
 		template <class _Ty, storage_type s>
-		userdata_obj<_Ty, s>* push_obj(lua_State* L) noexcept
+		userdata_obj<_Ty, s>* new_obj(lua_State* L, class_info_data* info) noexcept
 		{
-			auto& info = detail::class_info<typename std::remove_cv<_Ty>::type>::info_data_map[get_main(L)];
-			LB_ASSERT(info.class_id);
+			LB_ASSERT(info);
+			materialize(L, info);
+			LB_ASSERT(info->meta_ref);
 			auto data = (userdata_obj<_Ty, s>*)lua_newuserdata(L, sizeof(userdata_obj<_Ty, s>));
 			data->info.type = USERDATA_CLASS;
 			data->info.storage = s;
-			data->info.type_id = info.type_id;
-			lua_rawgeti(L, LUA_REGISTRYINDEX, info.class_id);
-			LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
-			LB_ASSERT_EQ(lua_getmetatable(L, -1), 1);
-			lua_rawgeti(L, -1, INDEX_CLASS);
+			data->info.type_id = info->type_id;
+			return data;
+		}
+
+		inline void set_obj_meta(lua_State* L, class_info_data* info) noexcept
+		{
+			lua_rawgeti(L, LUA_REGISTRYINDEX, info->meta_ref);
 			LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
-			lua_setmetatable(L, -4);
-			lua_pop(L, 2);
+			lua_setmetatable(L, -2);
+		}
+
+		inline void push_unregistered(lua_State* L) noexcept
+		{
+			LB_LOG_E("push an object of unregistered c++ class");
+			lua_pushnil(L);
+		}
+
+		template <class _Ty, storage_type s>
+		userdata_obj<_Ty, s>* push_obj(lua_State* L) noexcept
+		{
+			auto info = find_class_info<_Ty>(L);
+			if (!info)
+			{
+				push_unregistered(L);
+				return nullptr;
+			}
+			auto data = new_obj<_Ty, s>(L, info);
+			set_obj_meta(L, info);
 			return data;
 		}
+
+		template <class _Ty, storage_type s, class _Init, class _Check>
+		void push_identity_obj(lua_State* L, const void* key, _Init&& init, _Check&& check) noexcept
+		{
+			env* e = get_env(L);
+			auto info = e->find_class<_Ty>();
+			if (!info)
+			{
+				push_unregistered(L);
+				return;
+			}
+			if (!key || !(info->flags & CLASS_IDENTITY))
+			{
+				init(new_obj<_Ty, s>(L, info));
+				set_obj_meta(L, info);
+				return;
+			}
+			if (!info->identity_ref)
+			{
+				lua_createtable(L, STORAGE_MAX, 0);
+				info->identity_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+			}
+			lua_rawgeti(L, LUA_REGISTRYINDEX, info->identity_ref);
+			LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
+			lua_rawgeti(L, -1, s + 1);
+			if (lua_type(L, -1) != LUA_TTABLE)
+			{
+				lua_pop(L, 1);
+				lua_createtable(L, 0, 0);
+				lua_createtable(L, 0, 1);
+				lua_pushstring(L, "__mode");
+				lua_pushstring(L, "v");
+				lua_rawset(L, -3);
+				lua_setmetatable(L, -2);
+				lua_pushvalue(L, -1);
+				lua_rawseti(L, -3, s + 1);
+			}
+			lua_remove(L, -2);
+			lua_pushlightuserdata(L, (void*)key);
+			lua_rawget(L, -2);
+			if (lua_type(L, -1) == LUA_TUSERDATA)
+			{
+				auto data = (userdata_obj<_Ty, s>*)lua_touserdata(L, -1);
+				if (data->info.type == USERDATA_CLASS && data->info.storage == s && check(data))
+				{
+					++e->identity_hits;
+					lua_remove(L, -2);
+					return;
+				}
+			}
+			lua_pop(L, 1);
+			++e->identity_misses;
+			init(new_obj<_Ty, s>(L, info));
+			set_obj_meta(L, info);
+			lua_pushlightuserdata(L, (void*)key);
+			lua_pushvalue(L, -2);
+			lua_rawset(L, -4);
+			lua_remove(L, -2);
+		}
+
+		template <class _Ty, class _Ptr>
+		int push_shared_obj(lua_State* L, _Ptr&& val) noexcept
+		{
+			typedef userdata_obj<_Ty, STORAGE_S_PTR> obj_type;
+			const void* key = val.get();
+			push_identity_obj<_Ty, STORAGE_S_PTR>(L, key, [&val](obj_type* obj) noexcept
+			{
+				new (&obj->data) std::shared_ptr<_Ty>(std::forward<_Ptr>(val));
+			}, [](obj_type*) noexcept
+			{
+				return true;
+			});
+			return 1;
+		}
+
+		template <class _Ty, class _Ptr>
+		int push_weak_obj(lua_State* L, _Ptr&& val) noexcept
+		{
+			typedef userdata_obj<_Ty, STORAGE_W_PTR> obj_type;
+			const void* key = val.lock().get();
+			push_identity_obj<_Ty, STORAGE_W_PTR>(L, key, [&val](obj_type* obj) noexcept
+			{
+				new (&obj->data) std::weak_ptr<_Ty>(std::forward<_Ptr>(val));
+			}, [&val](obj_type* obj) noexcept
+			{
+				return !obj->data.expired() && !obj->data.owner_before(val) && !val.owner_before(obj->data);
+			});
+			return 1;
+		}
+
+		template <class _Ty, class _Gen>
+		int emplace_obj(lua_State* L, _Gen&& gen) noexcept
+		{
+			auto info = find_class_info<_Ty>(L);
+			if (!info)
+			{
+				gen();
+				push_unregistered(L);
+				return 1;
+			}
+			auto data = new_obj<_Ty, STORAGE_LUA>(L, info);
+			int pos = lua_gettop(L);
+			new (&data->data) _Ty(gen());
+			if (lua_gettop(L) != pos)
+			{
+				lua_pushvalue(L, pos);
+			}
+			set_obj_meta(L, info);
+			return 1;
+		}
 	}
 
 	template <class _Ty>
@@ -175,13 +288,32 @@ namespace luabind
 			return obj->data;
 		}
 
-		static int push(lua_State* L, _Ty val) noexcept
+		static int push(lua_State* L, const _Ty& val) noexcept
 		{
 			auto obj = detail::push_obj<_Ty, STORAGE_LUA>(L);
-			new (&obj->data) _Ty(val);
+			if (obj)
+			{
+				new (&obj->data) _Ty(val);
+			}
 			return 1;
 		}
 
+		static int push(lua_State* L, _Ty&& val) noexcept
+		{
+			auto obj = detail::push_obj<_Ty, STORAGE_LUA>(L);
+			if (obj)
+			{
+				new (&obj->data) _Ty(std::move(val));
+			}
+			return 1;
+		}
+
+		template <class _Gen>
+		static int emplace(lua_State* L, _Gen&& gen) noexcept
+		{
+			return detail::emplace_obj<_Ty>(L, std::forward<_Gen>(gen));
+		}
+
 		static _Ty make_default() noexcept
 		{
 			return _Ty();
@@ -212,7 +344,10 @@ namespace luabind
 		static int push(lua_State* L, _Ty& val) noexcept
 		{
 			auto obj = detail::push_obj<_Ty, STORAGE_LUA>(L);
-			new (&obj->data) _Ty(val);
+			if (obj)
+			{
+				new (&obj->data) _Ty(val);
+			}
 			return 1;
 		}
 
@@ -236,7 +371,10 @@ namespace luabind
 		static int push(lua_State* L, _Ty&& val) noexcept
 		{
 			auto obj = detail::push_obj<_Ty, STORAGE_LUA>(L);
-			new (&obj->data) _Ty(val);
+			if (obj)
+			{
+				new (&obj->data) _Ty(std::move(val));
+			}
 			return 1;
 		}
 	};
@@ -264,9 +402,15 @@ namespace luabind
 
 		static int push(lua_State* L, _Ty* val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_I_PTR>(L);
-			obj->data = val;
-			intrusive_obj<_Ty>::inc(obj->data);
+			typedef detail::userdata_obj<_Ty, STORAGE_I_PTR> obj_type;
+			detail::push_identity_obj<_Ty, STORAGE_I_PTR>(L, val, [val](obj_type* obj) noexcept
+			{
+				obj->data = val;
+				intrusive_obj<_Ty>::inc(obj->data);
+			}, [](obj_type*) noexcept
+			{
+				return true;
+			});
 			return 1;
 		}
 
@@ -302,7 +446,10 @@ namespace luabind
 		static int push(lua_State* L, std::unique_ptr<_Ty> val) noexcept
 		{
 			auto obj = detail::push_obj<_Ty, STORAGE_U_PTR>(L);
-			new (&obj->data) std::unique_ptr<_Ty>(std::move(val));
+			if (obj)
+			{
+				new (&obj->data) std::unique_ptr<_Ty>(std::move(val));
+			}
 			return 1;
 		}
 
@@ -326,7 +473,10 @@ namespace luabind
 		static int push(lua_State* L, std::unique_ptr<_Ty>& val) noexcept
 		{
 			auto obj = detail::push_obj<_Ty, STORAGE_U_PTR>(L);
-			new (&obj->data) std::unique_ptr<_Ty>(std::move(val));
+			if (obj)
+			{
+				new (&obj->data) std::unique_ptr<_Ty>(std::move(val));
+			}
 			return 1;
 		}
 	};
@@ -370,7 +520,10 @@ namespace luabind
 		static int push(lua_State* L, std::unique_ptr<_Ty>&& val) noexcept
 		{
 			auto obj = detail::push_obj<_Ty, STORAGE_U_PTR>(L);
-			new (&obj->data) std::unique_ptr<_Ty>(std::move(val));
+			if (obj)
+			{
+				new (&obj->data) std::unique_ptr<_Ty>(std::move(val));
+			}
 			return 1;
 		}
 	};
@@ -407,9 +560,7 @@ namespace luabind
 
 		static int push(lua_State* L, std::shared_ptr<_Ty> val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_S_PTR>(L);
-			new (&obj->data) std::shared_ptr<_Ty>(val);
-			return 1;
+			return detail::push_shared_obj<_Ty>(L, std::move(val));
 		}
 
 		static std::shared_ptr<_Ty> make_default() noexcept
@@ -431,9 +582,7 @@ namespace luabind
 
 		static int push(lua_State* L, std::shared_ptr<_Ty>& val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_S_PTR>(L);
-			new (&obj->data) std::shared_ptr<_Ty>(val);
-			return 1;
+			return detail::push_shared_obj<_Ty>(L, val);
 		}
 	};
 
@@ -462,9 +611,7 @@ namespace luabind
 
 		static int push(lua_State* L, const std::shared_ptr<_Ty>& val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_S_PTR>(L);
-			new (&obj->data) std::shared_ptr<_Ty>(val);
-			return 1;
+			return detail::push_shared_obj<_Ty>(L, val);
 		}
 	};
 
@@ -481,9 +628,7 @@ namespace luabind
 
 		static int push(lua_State* L, std::shared_ptr<_Ty>&& val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_S_PTR>(L);
-			new (&obj->data) std::shared_ptr<_Ty>(std::move(val));
-			return 1;
+			return detail::push_shared_obj<_Ty>(L, std::move(val));
 		}
 	};
 
@@ -519,9 +664,7 @@ namespace luabind
 
 		static int push(lua_State* L, std::weak_ptr<_Ty> val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_W_PTR>(L);
-			new (&obj->data) std::weak_ptr<_Ty>(val);
-			return 1;
+			return detail::push_weak_obj<_Ty>(L, std::move(val));
 		}
 
 		static std::weak_ptr<_Ty> make_default() noexcept
@@ -543,9 +686,7 @@ namespace luabind
 
 		static int push(lua_State* L, std::weak_ptr<_Ty>& val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_W_PTR>(L);
-			new (&obj->data) std::weak_ptr<_Ty>(val);
-			return 1;
+			return detail::push_weak_obj<_Ty>(L, val);
 		}
 	};
 
@@ -574,9 +715,7 @@ namespace luabind
 
 		static int push(lua_State* L, const std::weak_ptr<_Ty>& val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_W_PTR>(L);
-			new (&obj->data) std::weak_ptr<_Ty>(val);
-			return 1;
+			return detail::push_weak_obj<_Ty>(L, val);
 		}
 	};
 
@@ -593,9 +732,7 @@ namespace luabind
 
 		static int push(lua_State* L, std::weak_ptr<_Ty>&& val) noexcept
 		{
-			auto obj = detail::push_obj<_Ty, STORAGE_W_PTR>(L);
-			new (&obj->data) std::weak_ptr<_Ty>(std::move(val));
-			return 1;
+			return detail::push_weak_obj<_Ty>(L, std::move(val));
 		}
 	};
 }
@@ -30,6 +30,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
 namespace luabind
 {
 	struct scope;
@@ -53,6 +58,230 @@ namespace luabind
 
 	namespace detail
 	{
+		enum writer_status
+		{
+			WRITER_STATUS_MISSING = -1,
+			WRITER_STATUS_INVALID = -2
+		};
+
+		template <lua_CFunction _Gc>
+		void push_gc_meta(lua_State* L) noexcept
+		{
+			static const char key = 0;
+			lua_pushlightuserdata(L, (void*)&key);
+			lua_rawget(L, LUA_REGISTRYINDEX);
+			if (lua_type(L, -1) != LUA_TTABLE)
+			{
+				lua_pop(L, 1);
+				lua_createtable(L, 0, 1);
+				lua_pushstring(L, "__gc");
+				lua_pushcfunction(L, _Gc);
+				lua_rawset(L, -3);
+				lua_pushlightuserdata(L, (void*)&key);
+				lua_pushvalue(L, -2);
+				lua_rawset(L, LUA_REGISTRYINDEX);
+			}
+		}
+
+		//Active on the thread while a binding_set records or replays its scope tree.
+		//Recording keeps every table enrollment creates so its final size can be
+		//measured; replaying creates the tables in the same order presized.
+		struct binding_replay
+		{
+			bool recording = false;
+			std::vector<std::pair<int, int>>* shapes = nullptr;
+			size_t next_shape = 0;
+			std::vector<int> tables;
+		};
+
+		inline binding_replay*& active_replay() noexcept
+		{
+			static thread_local binding_replay* replay = nullptr;
+			return replay;
+		}
+
+		inline void new_table(lua_State* L, int narr = 0, int nrec = 0) noexcept
+		{
+			binding_replay* r = active_replay();
+			if (r)
+			{
+				if (r->recording)
+				{
+					lua_createtable(L, narr, nrec);
+					lua_pushvalue(L, -1);
+					r->tables.push_back(luaL_ref(L, LUA_REGISTRYINDEX));
+					return;
+				}
+				if (r->next_shape < r->shapes->size())
+				{
+					narr = (*r->shapes)[r->next_shape].first;
+					nrec = (*r->shapes)[r->next_shape].second;
+					++r->next_shape;
+				}
+			}
+			lua_createtable(L, narr, nrec);
+		}
+
+		//Hands out the holder an enrollment records for a binding_set, or a fresh
+		//one outside of it. Only recording fills the cache, so replays never write
+		//to enrollments they share with other threads.
+		template <class _Holder, class _Make>
+		_Holder* get_holder(_Holder*& cache, bool& shared, _Make&& make) noexcept
+		{
+			binding_replay* r = active_replay();
+			shared = r && (cache || r->recording);
+			if (!shared)
+			{
+				return make();
+			}
+			if (!cache)
+			{
+				cache = make();
+			}
+			return cache;
+		}
+
+		template <class _Holder>
+		void release_holder(_Holder*& cache) noexcept
+		{
+			if (cache)
+			{
+				cache->release();
+				cache = nullptr;
+			}
+		}
+
+		inline const char* get_full_name(std::string& cache, const char* super_name,
+			const char* name, char* buf) noexcept
+		{
+			binding_replay* r = active_replay();
+			if (r && !cache.empty())
+			{
+				return cache.c_str();
+			}
+			if (*super_name)
+			{
+				sprintf(buf, "%s.%s", super_name, name);
+			}
+			else
+			{
+				sprintf(buf, "%s", name);
+			}
+			if (r && r->recording)
+			{
+				cache = buf;
+			}
+			return buf;
+		}
+
+		inline void push_holder(lua_State* L, func_holder* h, bool shared) noexcept
+		{
+			if (shared)
+			{
+				void* data = lua_newuserdata(L, sizeof(func_holder*) + sizeof(shared_func_holder));
+				*(func_holder**)data = new ((func_holder**)data + 1) shared_func_holder(h);
+				push_gc_meta<&shared_func_holder::__gc>(L);
+			}
+			else
+			{
+				*(func_holder**)lua_newuserdata(L, sizeof(func_holder*)) = h;
+				push_gc_meta<&func_holder::__gc>(L);
+			}
+			lua_setmetatable(L, -2);
+		}
+
+		inline func_holder* chain_holder(func_holder* h, bool shared) noexcept
+		{
+			return shared ? new shared_func_holder(h) : h;
+		}
+
+		struct accessor
+		{
+			virtual ~accessor() noexcept = default;
+
+			virtual int read(lua_State* L, int self) noexcept
+			{
+				return 0;
+			}
+
+			virtual int write(lua_State* L, int self, int val) noexcept
+			{
+				return WRITER_UNKNOWN_FIALED;
+			}
+
+			static int __gc(lua_State* L) noexcept
+			{
+				((accessor*)lua_touserdata(L, 1))->~accessor();
+				return 0;
+			}
+
+			template <class _Accessor>
+			static _Accessor* push(lua_State* L, const _Accessor& a) noexcept
+			{
+				static_assert(std::is_base_of<accessor, _Accessor>::value,
+					"_Accessor need to be an accessor.");
+				_Accessor* data = new(lua_newuserdata(L, sizeof(_Accessor))) _Accessor(a);
+				push_gc_meta<&__gc>(L);
+				lua_setmetatable(L, -2);
+				return data;
+			}
+		};
+
+		inline int call_reader(lua_State* L, int self) noexcept
+		{
+			if (lua_type(L, -1) == LUA_TUSERDATA)
+			{
+				if (!((accessor*)lua_touserdata(L, -1))->read(L, self))
+				{
+					lua_pushnil(L);
+				}
+				return 1;
+			}
+			LB_ASSERT(lua_type(L, -1) == LUA_TFUNCTION);
+			if (self)
+			{
+				lua_pushvalue(L, self);
+			}
+			if (lua_pcall(L, self ? 1 : 0, 1, 0))
+			{
+				return luaL_error(L, "%s", lua_tostring(L, -1));
+			}
+			return 1;
+		}
+
+		inline int call_writer(lua_State* L, int self, int val) noexcept
+		{
+			if (lua_type(L, -1) == LUA_TUSERDATA)
+			{
+				return ((accessor*)lua_touserdata(L, -1))->write(L, self, val);
+			}
+			LB_ASSERT(lua_type(L, -1) == LUA_TFUNCTION);
+			if (self)
+			{
+				lua_pushvalue(L, self);
+			}
+			lua_pushvalue(L, val);
+			if (lua_pcall(L, self ? 2 : 1, 1, 0))
+			{
+				return luaL_error(L, "%s", lua_tostring(L, -1));
+			}
+			switch (lua_type(L, -1))
+			{
+			case LUA_TNUMBER:
+				return (int)lua_tointeger(L, -1);
+			case LUA_TNIL:
+				return WRITER_STATUS_MISSING;
+			default:
+				return WRITER_STATUS_INVALID;
+			}
+		}
+
+		inline bool is_accessor(lua_State* L, int idx) noexcept
+		{
+			int t = lua_type(L, idx);
+			return t == LUA_TUSERDATA || t == LUA_TFUNCTION;
+		}
+
 		struct enrollment
 		{
 			enrollment() noexcept = default;
@@ -68,6 +297,25 @@ namespace luabind
 
 			static void gettable(lua_State* L, const char* name) noexcept
 			{
+				lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
+				if (lua_type(L, -1) == LUA_TSTRING && !*lua_tostring(L, -1))
+				{
+#					if (LUA_VERSION_NUM >= 502)
+					lua_pushglobaltable(L);
+#					else
+					lua_pushvalue(L, LUA_GLOBALSINDEX);
+#					endif
+					lua_pushstring(L, name);
+					lua_rawget(L, -2);
+					if (lua_type(L, -1) == LUA_TTABLE)
+					{
+						lua_replace(L, -3);
+						lua_pop(L, 1);
+						return;
+					}
+					lua_pop(L, 2);
+				}
+				lua_pop(L, 1);
 				lua_pushstring(L, name);
 #				if (LUA_VERSION_NUM >= 503)
 				if (!lua_rawget(L, -2))
@@ -77,7 +325,7 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushstring(L, name);
 					lua_pushvalue(L, -2);
 					lua_rawset(L, -4);
@@ -91,21 +339,10 @@ namespace luabind
 			static int inner_index(lua_State* L) noexcept
 			{
 				lua_pushvalue(L, -1);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawget(L, lua_upvalueindex(1)) == LUA_TFUNCTION)
-#				else
 				lua_rawget(L, lua_upvalueindex(1));
-				if (lua_type(L, -1) == LUA_TFUNCTION)
-#				endif
+				if (is_accessor(L, -1))
 				{
-					if (lua_pcall(L, 0, 1, 0))
-					{
-						return luaL_error(L, lua_tostring(L, -1));
-					}
-					else
-					{
-						return 1;
-					}
+					return call_reader(L, 0);
 				}
 				return 0;
 			}
@@ -120,13 +357,13 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -4, INDEX_READER);
 				}
 				if (!lua_getmetatable(L, -2))
 				{
-					lua_newtable(L);
+					new_table(L);
 					lua_pushstring(L, "__index");
 					lua_pushvalue(L, -3);
 					lua_pushcclosure(L, &inner_index, 1);
@@ -149,7 +386,7 @@ namespace luabind
 #				endif
 				{
 					lua_pop(L, 1);
-					lua_newtable(L);
+					new_table(L);
 					lua_pushvalue(L, -1);
 					lua_rawseti(L, -4, INDEX_WRITER);
 				}
@@ -207,55 +444,59 @@ namespace luabind
 		};
 
 		template <class _Type>
-		int value_reader(lua_State* L) noexcept
+		struct value_reader : accessor
 		{
 			static_assert(type_traits<_Type>::can_push
 				&& type_traits<_Type>::stack_count == 1, "wrong type for reader.");
-			return type_traits<_Type>::push(L, *(_Type*)lua_touserdata(L, lua_upvalueindex(1)));
-		}
+
+			value_reader(_Type* v) noexcept : val(v) {}
+
+			virtual int read(lua_State* L, int self) noexcept
+			{
+				return type_traits<_Type>::push(L, *val);
+			}
+
+			_Type* val;
+		};
 
 		template <class _Type>
-		struct func_reader : enrollment
+		struct func_reader : accessor
 		{
 			static_assert(type_traits<_Type>::can_push
 				&& type_traits<_Type>::stack_count == 1, "wrong type for reader.");
 
+			static_assert(!is_yield_result<_Type>::value,
+				"yield_result can only be returned by functions bound with def.");
+
 			typedef std::function<_Type()> func_type;
 
-			static int __gc(lua_State* L) noexcept
-			{
-				func_type& func = *(func_type*)lua_touserdata(L, 1);
-				func.~func_type();
-				return 0;
-			}
+			func_reader(func_type&& f) noexcept : func(f) {}
 
-			static int reader(lua_State* L) noexcept
+			virtual int read(lua_State* L, int self) noexcept
 			{
-				func_type& func = *(func_type*)lua_touserdata(L, lua_upvalueindex(1));
 				return type_traits<_Type>::push(L, func());
 			}
 
-			func_reader(const char* n, func_type&& f) noexcept
-				: name(n), func(f) {}
+			func_type func;
+		};
+
+		template <class _Accessor>
+		struct accessor_reader : enrollment
+		{
+			accessor_reader(const char* n, _Accessor&& a) noexcept
+				: name(n), acc(std::move(a)) {}
 
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				LUABIND_HOLD_STACK(L);
 				getreader(L);
 				lua_pushstring(L, name);
-				void* data = lua_newuserdata(L, sizeof(func_type));
-				new(data) func_type(func);
-				lua_newtable(L);
-				lua_pushstring(L, "__gc");
-				lua_pushcfunction(L, &__gc);
-				lua_rawset(L, -3);
-				lua_setmetatable(L, -2);
-				lua_pushcclosure(L, &reader, 1);
+				accessor::push(L, acc);
 				lua_rawset(L, -3);
 			}
 
 			const char* name;
-			func_type func;
+			_Accessor acc;
 		};
 
 		template <class... _Types>
@@ -284,79 +525,66 @@ namespace luabind
 		};
 
 		template <class _Type>
-		int value_writer(lua_State* L) noexcept
+		struct value_writer : accessor
 		{
 			static_assert(type_traits<_Type>::can_get
 				&& type_traits<_Type>::stack_count == 1, "wrong type for writer.");
-			if (type_traits<_Type>::test(L, -1))
-			{
-				*(_Type*)lua_touserdata(L, lua_upvalueindex(1)) = type_traits<_Type>::get(L, -1);
-				lua_pushinteger(L, WRITER_SUCCEEDED);
-			}
-			else
+
+			value_writer(_Type* v) noexcept : val(v) {}
+
+			virtual int write(lua_State* L, int self, int idx) noexcept
 			{
-				lua_pushinteger(L, WRITER_TYPE_FAILED);
+				if (type_traits<_Type>::test(L, idx))
+				{
+					*val = type_traits<_Type>::get(L, idx);
+					return WRITER_SUCCEEDED;
+				}
+				return WRITER_TYPE_FAILED;
 			}
-			return 1;
-		}
+
+			_Type* val;
+		};
 
 		template <class _Type>
-		struct func_writer : enrollment
+		struct func_writer : accessor
 		{
 			static_assert(type_traits<_Type>::can_get
 				&& type_traits<_Type>::stack_count == 1, "wrong type for writer.");
 
 			typedef std::function<bool(_Type)> func_type;
 
-			static int __gc(lua_State* L) noexcept
-			{
-				func_type& func = *(func_type*)lua_touserdata(L, 1);
-				func.~func_type();
-				return 0;
-			}
+			func_writer(func_type&& f) noexcept : func(f) {}
 
-			static int writer(lua_State* L) noexcept
+			virtual int write(lua_State* L, int self, int idx) noexcept
 			{
-				if (type_traits<_Type>::test(L, -1))
-				{
-					func_type& func = *(func_type*)lua_touserdata(L, lua_upvalueindex(1));
-					if (func(type_traits<_Type>::get(L, -1)))
-					{
-						lua_pushinteger(L, WRITER_SUCCEEDED);
-					}
-					else
-					{
-						lua_pushinteger(L, WRITER_VALUE_FAILED);
-					}
-				}
-				else
+				if (type_traits<_Type>::test(L, idx))
 				{
-					lua_pushinteger(L, WRITER_TYPE_FAILED);
+					return func(type_traits<_Type>::get(L, idx))
+						? WRITER_SUCCEEDED : WRITER_VALUE_FAILED;
 				}
-				return 1;
+				return WRITER_TYPE_FAILED;
 			}
 
-			func_writer(const char* n, func_type&& f) noexcept
-				: name(n), func(f) {}
+			func_type func;
+		};
+
+		template <class _Accessor>
+		struct accessor_writer : enrollment
+		{
+			accessor_writer(const char* n, _Accessor&& a) noexcept
+				: name(n), acc(std::move(a)) {}
 
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				LUABIND_HOLD_STACK(L);
 				getwriter(L);
 				lua_pushstring(L, name);
-				void* data = lua_newuserdata(L, sizeof(func_type));
-				new(data) func_type(func);
-				lua_newtable(L);
-				lua_pushstring(L, "__gc");
-				lua_pushcfunction(L, &__gc);
-				lua_rawset(L, -3);
-				lua_setmetatable(L, -2);
-				lua_pushcclosure(L, &writer, 1);
+				accessor::push(L, acc);
 				lua_rawset(L, -3);
 			}
 
 			const char* name;
-			func_type func;
+			_Accessor acc;
 		};
 
 		template <class... _Types>
@@ -383,6 +611,67 @@ namespace luabind
 			holder upvalues;
 		};
 
+		inline void enroll_func(lua_State* L, const char* name, func_holder* holder,
+			lua_CFunction single, const static_holder_desc<func_holder>* desc = nullptr,
+			bool shared = false) noexcept
+		{
+			LUABIND_HOLD_STACK(L);
+			int table = lua_gettop(L);
+			int meta = table - 1;
+#			if (LUA_VERSION_NUM >= 503)
+			if (lua_rawgeti(L, meta, INDEX_FUNC) != LUA_TTABLE)
+#			else
+			lua_rawgeti(L, meta, INDEX_FUNC);
+			if (lua_type(L, -1) != LUA_TTABLE)
+#			endif
+			{
+				lua_pop(L, 1);
+				new_table(L);
+				lua_pushvalue(L, -1);
+				lua_rawseti(L, meta, INDEX_FUNC);
+			}
+			LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
+			lua_pushstring(L, name);
+			lua_rawget(L, -2);
+			if (lua_type(L, -1) == LUA_TLIGHTUSERDATA)
+			{
+				func_holder* first = ((const static_holder_desc<func_holder>*)
+					lua_touserdata(L, -1))->create();
+				lua_pop(L, 1);
+				push_holder(L, first, false);
+				lua_pushstring(L, name);
+				lua_pushvalue(L, -2);
+				lua_rawset(L, -4);
+			}
+			if (lua_type(L, -1) != LUA_TUSERDATA)
+			{
+				lua_pop(L, 1);
+				if (holder)
+				{
+					push_holder(L, holder, shared);
+				}
+				else
+				{
+					lua_pushlightuserdata(L, (void*)desc);
+				}
+				lua_pushstring(L, name);
+				lua_pushvalue(L, -2);
+				lua_rawset(L, -4);
+			}
+			else
+			{
+				(*(func_holder**)lua_touserdata(L, -1))->append(
+					holder ? chain_holder(holder, shared) : desc->create());
+				single = &func_holder::entry;
+			}
+			lua_pushstring(L, name);
+			lua_pushvalue(L, -2);
+			lua_rawgeti(L, meta, INDEX_SCOPE_NAME);
+			lua_pushstring(L, name);
+			lua_pushcclosure(L, single, 3);
+			lua_rawset(L, table);
+		}
+
 		template <class _Shell, class... _Types>
 		struct cpp_func : enrollment
 		{
@@ -392,69 +681,58 @@ namespace luabind
 			cpp_func(const char* n, _Shell& f, _Types... pak) noexcept
 				: name(n), func(std::move(f.func)), values(pak...) {}
 
+			virtual ~cpp_func() noexcept
+			{
+				release_holder(shared);
+			}
+
 			virtual void enroll(lua_State* L) const noexcept
 			{
-				LUABIND_HOLD_STACK(L);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawgeti(L, -2, INDEX_FUNC) != LUA_TTABLE)
-#				else
-				lua_rawgeti(L, -2, INDEX_FUNC);
-				if (lua_type(L, -1) != LUA_TTABLE)
-#				endif
-				{
-					lua_pop(L, 1);
-					lua_newtable(L);
-					lua_pushvalue(L, -1);
-					lua_rawseti(L, -4, INDEX_FUNC);
-				}
-				LB_ASSERT(lua_type(L, -1) == LUA_TTABLE);
-				lua_pushstring(L, name);
-#				if (LUA_VERSION_NUM >= 503)
-				if (lua_rawget(L, -2) != LUA_TUSERDATA)
-#				else
-				lua_rawget(L, -2);
-				if (lua_type(L, -1) != LUA_TUSERDATA)
-#				endif
+				bool is_shared;
+				func_holder* h = get_holder(shared, is_shared, [this]() noexcept -> func_holder*
 				{
-					lua_pop(L, 1);
-					void* data = lua_newuserdata(L, sizeof(func_holder*));
-					*(func_holder**)data = new func_holder_impl<_Shell>(func, values);
-					lua_newtable(L);
-					lua_pushstring(L, "__gc");
-					lua_pushcfunction(L, &func_holder::__gc);
-					lua_rawset(L, -3);
-					lua_setmetatable(L, -2);
-					lua_pushstring(L, name);
-					lua_pushvalue(L, -2);
-					lua_rawset(L, -4);
-					lua_rawgeti(L, -4, INDEX_SCOPE_NAME);
-					lua_pushstring(L, name);
-					lua_pushcclosure(L, &func_holder::entry, 3);
-					lua_pushstring(L, name);
-					lua_pushvalue(L, -2);
-					lua_rawset(L, -5);
-				}
-				else
+					return new func_holder_impl<_Shell>(func, values);
+				});
+				enroll_func(L, name, h, &func_holder::entry, nullptr, is_shared);
+			}
+
+			const char* name;
+			func_type func;
+			val_type values;
+			mutable func_holder* shared = nullptr;
+		};
+
+		template <class _Shell, typename _Shell::func_type _Target, class... _Types>
+		struct static_func : enrollment
+		{
+			typedef static_func_holder<_Shell, _Target> holder;
+			typedef typename _Shell::val_type val_type;
+
+			static_func(const char* n, _Types... pak) noexcept
+				: name(n), values(pak...) {}
+
+			virtual ~static_func() noexcept
+			{
+				release_holder(shared);
+			}
+
+			virtual void enroll(lua_State* L) const noexcept
+			{
+				bool is_shared = false;
+				func_holder* h = nullptr;
+				if (std::tuple_size<val_type>::value)
 				{
-					func_holder* h = *(func_holder**)lua_touserdata(L, -1);
-					while (true)
+					h = get_holder(shared, is_shared, [this]() noexcept -> func_holder*
 					{
-						if (h->next)
-						{
-							h = h->next;
-						}
-						else
-						{
-							h->next = new func_holder_impl<_Shell>(func, values);
-							break;
-						}
-					}
+						return new holder(values);
+					});
 				}
+				enroll_func(L, name, h, &holder::entry, holder::desc(), is_shared);
 			}
 
 			const char* name;
-			func_type func;
 			val_type values;
+			mutable func_holder* shared = nullptr;
 		};
 	}
 
@@ -525,6 +803,11 @@ namespace luabind
 			return *this;
 		}
 
+		bool empty() const noexcept
+		{
+			return !chain;
+		}
+
 		void enroll(lua_State* L) const noexcept
 		{
 			for (detail::enrollment* r = chain; r != 0; r = r->next)
@@ -569,21 +852,12 @@ namespace luabind
 #				endif
 				{
 					lua_pushvalue(L, 2);
-#					if (LUA_VERSION_NUM >= 503)
-					if (lua_rawget(L, -2) == LUA_TFUNCTION)
-#					else
 					lua_rawget(L, -2);
-					if (lua_type(L, -1) == LUA_TFUNCTION)
-#					endif
+					if (detail::is_accessor(L, -1))
 					{
-						lua_pushvalue(L, 3);
-						if (lua_pcall(L, 1, 1, 0))
-						{
-							return luaL_error(L, lua_tostring(L, -1));
-						}
-						else if (lua_type(L, -1) == LUA_TNUMBER)
+						int res = detail::call_writer(L, 0, 3);
+						if (res >= 0)
 						{
-							auto res = lua_tointeger(L, -1);
 							if (res == WRITER_SUCCEEDED)
 							{
 								return 0;
@@ -700,7 +974,7 @@ namespace luabind
 			{
 				if (!lua_getmetatable(L, -1))
 				{
-					lua_newtable(L);
+					detail::new_table(L, INDEX_WRITER, 3);
 					lua_pushvalue(L, -1);
 					lua_setmetatable(L, -3);
 				}
@@ -722,7 +996,7 @@ namespace luabind
 					lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
 					lua_pushcclosure(L, &namespace_::__tostring, 1);
 					lua_rawset(L, -3);
-					lua_newtable(L);
+					detail::new_table(L);
 					lua_pushstring(L, "__newindex");
 					lua_pushvalue(L, -2);
 					lua_rawgeti(L, -4, INDEX_SCOPE_NAME);
@@ -744,18 +1018,11 @@ namespace luabind
 			virtual void enroll(lua_State* L) const noexcept
 			{
 				LUABIND_CHECK_STACK(L);
-				char full_name[LB_BUF_SIZE];
+				char buf[LB_BUF_SIZE];
 				lua_rawgeti(L, -2, INDEX_SCOPE_NAME);
 				LB_ASSERT(lua_type(L, -1) == LUA_TSTRING);
-				const char* super_name = lua_tostring(L, -1);
-				if (*super_name)
-				{
-					sprintf(full_name, "%s.%s", super_name, name);
-				}
-				else
-				{
-					sprintf(full_name, "%s", name);
-				}
+				const char* full_name = detail::get_full_name(recorded_name,
+					lua_tostring(L, -1), name, buf);
 				lua_pop(L, 1);
 				gettable(L, name);
 				getmetatable(L, full_name);
@@ -765,6 +1032,7 @@ namespace luabind
 
 			const char* name;
 			scope inner_scope;
+			mutable std::string recorded_name;
 		};
 
 
@@ -804,28 +1072,74 @@ namespace luabind
 		{
 			if (inner && inner->L)
 			{
-				lua_State* L = inner->L;
-				LB_ASSERT(!lua_gettop(L));
-				LUABIND_CHECK_STACK(L);
-#				if (LUA_VERSION_NUM >= 502)
-				lua_pushglobaltable(L);
-#				else
-				lua_pushvalue(L, LUA_GLOBALSINDEX);
-#				endif
+				enroll(inner, name, s);
+			}
+		}
+
+		static void enroll(env* e, const char* name, const scope& s) noexcept
+		{
+			lua_State* L = e->L;
+			LB_ASSERT(!lua_gettop(L));
+			LUABIND_CHECK_STACK(L);
+#			if (LUA_VERSION_NUM >= 502)
+			lua_pushglobaltable(L);
+#			else
+			lua_pushvalue(L, LUA_GLOBALSINDEX);
+#			endif
+			if (name)
+			{
+				getmodule(L, name);
+				namespace_::enrollment::getmetatable(L, name);
+				s.enroll(L);
+				lua_pop(L, 4);
+			}
+			else if (!s.empty())
+			{
 				namespace_::enrollment::getmetatable(L, "");
-				if (name)
-				{
-					namespace_::enrollment::gettable(L, name);
-					namespace_::enrollment::getmetatable(L, name);
-					s.enroll(L);
-					lua_pop(L, 3);
-				}
-				else
+				s.enroll(L);
+				lua_pop(L, 3);
+			}
+			else
+			{
+				lua_pop(L, 1);
+			}
+			e->touch();
+		}
+
+		//A named module is a plain field of _G, so _G only gets the root namespace
+		//metatable once module(L) binds something into it.
+		static void getmodule(lua_State* L, const char* name) noexcept
+		{
+			lua_pushstring(L, name);
+			lua_rawget(L, -2);
+			if (lua_type(L, -1) == LUA_TTABLE)
+			{
+				return;
+			}
+			lua_pop(L, 1);
+			if (lua_getmetatable(L, -1))
+			{
+				lua_rawgeti(L, -1, INDEX_SCOPE);
+				if (lua_type(L, -1) == LUA_TNUMBER && lua_tointeger(L, -1) == SCOPE_NAMESPACE)
 				{
-					s.enroll(L);
+					lua_pushstring(L, "__index");
+					lua_rawget(L, -3);
+					lua_pushstring(L, name);
+					lua_rawget(L, -2);
+					if (lua_type(L, -1) == LUA_TTABLE)
+					{
+						lua_replace(L, -4);
+						lua_pop(L, 2);
+						return;
+					}
+					lua_pop(L, 2);
 				}
-				lua_pop(L, 3);
+				lua_pop(L, 2);
 			}
+			detail::new_table(L);
+			lua_pushstring(L, name);
+			lua_pushvalue(L, -2);
+			lua_rawset(L, -4);
 		}
 
 	private:
@@ -838,6 +1152,140 @@ namespace luabind
 		return module_(L, name);
 	}
 
+	class binding_set
+	{
+	public:
+		struct stats
+		{
+			size_t count = 0;
+			uint64_t last_ns = 0;
+			uint64_t total_ns = 0;
+			uint64_t peak_ns = 0;
+		};
+
+		explicit binding_set(const char* n = nullptr) noexcept
+			: name(n)
+		{
+
+		}
+
+		binding_set(const binding_set&) = delete;
+
+		binding_set& operator = (const binding_set&) = delete;
+
+		binding_set& operator [] (scope s) noexcept
+		{
+			root.operator,(s);
+			return *this;
+		}
+
+		//The first call records the scope tree: holders go into the enrollments
+		//and the size of every table it builds is measured. Later calls share
+		//those holders and create the tables presized.
+		uint64_t instantiate(lua_State* L) noexcept
+		{
+			auto start = std::chrono::steady_clock::now();
+			env* e = get_env(L);
+			if (!e->L)
+			{
+				return 0;
+			}
+			detail::binding_replay replay;
+			replay.shapes = &shapes;
+			if (!recorded.load(std::memory_order_acquire))
+			{
+				std::lock_guard<std::mutex> lock(record_mutex);
+				if (!recorded.load(std::memory_order_relaxed))
+				{
+					replay.recording = true;
+					enroll(e, replay);
+					measure(L, replay.tables);
+					recorded.store(true, std::memory_order_release);
+				}
+			}
+			if (!replay.recording)
+			{
+				enroll(e, replay);
+			}
+			uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			++count;
+			last_ns = ns;
+			total_ns += ns;
+			uint64_t peak = peak_ns;
+			while (ns > peak)
+			{
+				if (peak_ns.compare_exchange_weak(peak, ns))
+				{
+					break;
+				}
+			}
+			return ns;
+		}
+
+		stats get_stats() const noexcept
+		{
+			stats s;
+			s.count = count;
+			s.last_ns = last_ns;
+			s.total_ns = total_ns;
+			s.peak_ns = peak_ns;
+			return s;
+		}
+
+	private:
+		void enroll(env* e, detail::binding_replay& replay) noexcept
+		{
+			detail::binding_replay* prev = detail::active_replay();
+			detail::active_replay() = &replay;
+			e->inc();
+			module_::enroll(e, name, root);
+			e->dec();
+			detail::active_replay() = prev;
+		}
+
+		void measure(lua_State* L, const std::vector<int>& tables) noexcept
+		{
+			shapes.reserve(tables.size());
+			for (int ref : tables)
+			{
+				lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+				int narr = 0;
+				for (;;)
+				{
+					lua_rawgeti(L, -1, narr + 1);
+					bool end = lua_isnil(L, -1);
+					lua_pop(L, 1);
+					if (end)
+					{
+						break;
+					}
+					++narr;
+				}
+				int total = 0;
+				lua_pushnil(L);
+				while (lua_next(L, -2))
+				{
+					lua_pop(L, 1);
+					++total;
+				}
+				lua_pop(L, 1);
+				luaL_unref(L, LUA_REGISTRYINDEX, ref);
+				shapes.emplace_back(narr, total - narr);
+			}
+		}
+
+		const char* name;
+		scope root;
+		std::vector<std::pair<int, int>> shapes;
+		std::mutex record_mutex;
+		std::atomic<bool> recorded{ false };
+		std::atomic<size_t> count{ 0 };
+		std::atomic<uint64_t> last_ns{ 0 };
+		std::atomic<uint64_t> total_ns{ 0 };
+		std::atomic<uint64_t> peak_ns{ 0 };
+	};
+
 	template <class... _Types>
 	scope def_manual(const char* name, lua_CFunction func, _Types... pak) noexcept
 	{
@@ -865,41 +1313,43 @@ namespace luabind
 	template <class _Type>
 	scope def_readonly(const char* name, const _Type& val) noexcept
 	{
-		return scope(new detail::manual_reader<void*>(name,
-			detail::value_reader<_Type>, (void*)&val));
+		return scope(new detail::accessor_reader<detail::value_reader<_Type>>(name,
+			detail::value_reader<_Type>(const_cast<_Type*>(&val))));
 	}
 
 	template <class _Type>
 	scope def_reader(const char* name, std::function<_Type()> func) noexcept
 	{
-		return scope(new detail::func_reader<_Type>(name, std::move(func)));
+		return scope(new detail::accessor_reader<detail::func_reader<_Type>>(name,
+			detail::func_reader<_Type>(std::move(func))));
 	}
 
 	template <class _Type>
 	scope def_reader(const char* name, _Type(*func)()) noexcept
 	{
-		return scope(new detail::func_reader<_Type>(name,
-			std::move(std::function<_Type()>(func))));
+		return scope(new detail::accessor_reader<detail::func_reader<_Type>>(name,
+			detail::func_reader<_Type>(std::function<_Type()>(func))));
 	}
 
 	template <class _Type>
 	scope def_writeonly(const char* name, _Type& val) noexcept
 	{
-		return scope(new detail::manual_writer<void*>(name,
-			detail::value_writer<_Type>, (void*)&val));
+		return scope(new detail::accessor_writer<detail::value_writer<_Type>>(name,
+			detail::value_writer<_Type>(&val)));
 	}
 
 	template <class _Type>
 	scope def_writer(const char* name, std::function<bool(_Type)> func) noexcept
 	{
-		return scope(new detail::func_writer<_Type>(name, std::move(func)));
+		return scope(new detail::accessor_writer<detail::func_writer<_Type>>(name,
+			detail::func_writer<_Type>(std::move(func))));
 	}
 
 	template <class _Type>
 	scope def_writer(const char* name, void(*func)(_Type)) noexcept
 	{
-		return scope(new detail::func_writer<_Type>(name,
-			std::move(std::function<void(_Type)>(func))));
+		return scope(new detail::accessor_writer<detail::func_writer<_Type>>(name,
+			detail::func_writer<_Type>(std::function<bool(_Type)>(func))));
 	}
 
 	template <class _Type>
@@ -920,8 +1370,27 @@ namespace luabind
 	scope def(const char* name, _Func* func, _Types... pak) noexcept
 	{
 		static_assert(std::is_function<_Func>::value, "_Func has to be a function.");
-		return def(name, std::function<_Func>(func), pak...);
+		return def(name, std::function<typename func_signature<_Func>::type>(func), pak...);
+	}
+
+	template <class _Func, _Func _Target, class... _Types>
+	scope def(const char* name, _Types... pak) noexcept
+	{
+		static_assert(std::is_pointer<_Func>::value
+			&& std::is_function<typename std::remove_pointer<_Func>::type>::value,
+			"_Target has to be a function.");
+		typedef decltype(create_func_shell<count_func_params(_Target) - (sizeof...(_Types))>(
+			_Target)) shell;
+		return scope(new detail::static_func<shell, _Target, _Types...>(name, pak...));
+	}
+
+#	ifdef __cpp_nontype_template_parameter_auto
+	template <auto _Target, class... _Types>
+	scope def(const char* name, _Types... pak) noexcept
+	{
+		return def<decltype(_Target), _Target>(name, pak...);
 	}
+#	endif
 
 	template <class _Val>
 	scope def(const char* name, _Val& val) noexcept
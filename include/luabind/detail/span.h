@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus
+//  File name:   span.h
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+
+namespace luabind
+{
+	namespace detail
+	{
+		struct span_state
+		{
+			void* data = nullptr;
+			size_t size = 0;
+			size_t stride = 0;
+			bool read_only = false;
+		};
+
+		struct span_userdata
+		{
+			header info;
+			std::shared_ptr<span_state> state;
+		};
+	}
+
+	template <class _Ty>
+	class span_view
+	{
+		static_assert(std::is_arithmetic<_Ty>::value, "_Ty has to be arithmetic.");
+
+	public:
+		typedef typename std::remove_const<_Ty>::type value_type;
+
+		span_view() noexcept = default;
+
+		span_view(_Ty* data, size_t size, bool read_only = false,
+			size_t stride = sizeof(_Ty)) noexcept
+			: state(std::make_shared<detail::span_state>())
+		{
+			state->data = (void*)const_cast<value_type*>(data);
+			state->size = size;
+			state->stride = stride;
+			state->read_only = read_only || std::is_const<_Ty>::value;
+		}
+
+		explicit span_view(const std::shared_ptr<detail::span_state>& s) noexcept
+			: state(s) {}
+
+		void reset(_Ty* data, size_t size) noexcept
+		{
+			if (state)
+			{
+				state->data = (void*)const_cast<value_type*>(data);
+				state->size = data ? size : 0;
+			}
+		}
+
+		void invalidate() noexcept
+		{
+			reset(nullptr, 0);
+		}
+
+		bool is_valid() const noexcept
+		{
+			return state && state->data;
+		}
+
+		bool is_read_only() const noexcept
+		{
+			return state ? state->read_only : true;
+		}
+
+		_Ty* data() const noexcept
+		{
+			return state ? (_Ty*)state->data : nullptr;
+		}
+
+		size_t size() const noexcept
+		{
+			return state ? state->size : 0;
+		}
+
+		size_t stride() const noexcept
+		{
+			return state ? state->stride : sizeof(_Ty);
+		}
+
+		_Ty& operator [] (size_t i) const noexcept
+		{
+			LB_ASSERT(is_valid() && i < state->size);
+			return *(_Ty*)((char*)state->data + i * state->stride);
+		}
+
+		const std::shared_ptr<detail::span_state>& get_state() const noexcept
+		{
+			return state;
+		}
+
+	private:
+		std::shared_ptr<detail::span_state> state;
+	};
+
+	namespace detail
+	{
+		template <class _Ty>
+		struct span_meta
+		{
+			typedef typename std::remove_const<_Ty>::type value_type;
+
+			static span_state* get_state(lua_State* L) noexcept
+			{
+				return ((span_userdata*)lua_touserdata(L, 1))->state.get();
+			}
+
+			static value_type& at(span_state* s, size_t i) noexcept
+			{
+				return *(value_type*)((char*)s->data + i * s->stride);
+			}
+
+			static int __index(lua_State* L) noexcept
+			{
+				span_state* s = get_state(L);
+				if (lua_type(L, 2) == LUA_TNUMBER)
+				{
+					if (!s->data)
+					{
+						return luaL_error(L, "access to an invalidated span.");
+					}
+					lua_Integer i = lua_tointeger(L, 2);
+					if (i >= 1 && size_t(i) <= s->size)
+					{
+						return type_traits<value_type>::push(L, at(s, size_t(i - 1)));
+					}
+				}
+				lua_pushnil(L);
+				return 1;
+			}
+
+			static int __newindex(lua_State* L) noexcept
+			{
+				span_state* s = get_state(L);
+				if (!s->data)
+				{
+					return luaL_error(L, "access to an invalidated span.");
+				}
+				if (s->read_only)
+				{
+					return luaL_error(L, "can not write to a read-only span.");
+				}
+				if (lua_type(L, 2) != LUA_TNUMBER)
+				{
+					return luaL_error(L, "span index has to be a number.");
+				}
+				lua_Integer i = lua_tointeger(L, 2);
+				if (i < 1 || size_t(i) > s->size)
+				{
+					char buf[96];
+					sprintf(buf, "span index %lld is out of range [1, %zu].", (long long)i, s->size);
+					return luaL_error(L, "%s", buf);
+				}
+				if (!type_traits<value_type>::test(L, 3))
+				{
+					return luaL_error(L, "the type of %s is not suitable for a span element.",
+						luaL_typename(L, 3));
+				}
+				at(s, size_t(i - 1)) = type_traits<value_type>::get(L, 3);
+				return 0;
+			}
+
+			static int __len(lua_State* L) noexcept
+			{
+				lua_pushinteger(L, (lua_Integer)get_state(L)->size);
+				return 1;
+			}
+
+			static int __gc(lua_State* L) noexcept
+			{
+				((span_userdata*)lua_touserdata(L, 1))->state.~shared_ptr();
+				return 0;
+			}
+
+			static void push_metatable(lua_State* L) noexcept
+			{
+				static const char key = 0;
+				lua_pushlightuserdata(L, (void*)&key);
+				lua_rawget(L, LUA_REGISTRYINDEX);
+				if (lua_type(L, -1) != LUA_TTABLE)
+				{
+					lua_pop(L, 1);
+					lua_createtable(L, 0, 4);
+					lua_pushstring(L, "__index");
+					lua_pushcfunction(L, &__index);
+					lua_rawset(L, -3);
+					lua_pushstring(L, "__newindex");
+					lua_pushcfunction(L, &__newindex);
+					lua_rawset(L, -3);
+					lua_pushstring(L, "__len");
+					lua_pushcfunction(L, &__len);
+					lua_rawset(L, -3);
+					lua_pushstring(L, "__gc");
+					lua_pushcfunction(L, &__gc);
+					lua_rawset(L, -3);
+					lua_pushlightuserdata(L, (void*)&key);
+					lua_pushvalue(L, -2);
+					lua_rawset(L, LUA_REGISTRYINDEX);
+				}
+			}
+		};
+	}
+
+	template <class _Ty>
+	struct type_traits<span_view<_Ty>>
+	{
+		static constexpr bool can_get = true;
+
+		static constexpr bool can_push = true;
+
+		static constexpr int stack_count = 1;
+
+		static bool test(lua_State* L, int idx) noexcept
+		{
+			if (lua_type(L, idx) == LUA_TUSERDATA)
+			{
+				detail::header* info = (detail::header*)lua_touserdata(L, idx);
+				return info->type == USERDATA_SPAN
+					&& info->type_id == detail::class_info<span_view<_Ty>>::index();
+			}
+			return false;
+		}
+
+		static span_view<_Ty> get(lua_State* L, int idx) noexcept
+		{
+			return span_view<_Ty>(((detail::span_userdata*)lua_touserdata(L, idx))->state);
+		}
+
+		static int push(lua_State* L, const span_view<_Ty>& val) noexcept
+		{
+			if (!val.get_state())
+			{
+				lua_pushnil(L);
+				return 1;
+			}
+			auto data = (detail::span_userdata*)lua_newuserdata(L, sizeof(detail::span_userdata));
+			data->info.type = USERDATA_SPAN;
+			data->info.storage = STORAGE_LUA;
+			data->info.type_id = detail::class_info<span_view<_Ty>>::index();
+			new (&data->state) std::shared_ptr<detail::span_state>(val.get_state());
+			detail::span_meta<_Ty>::push_metatable(L);
+			lua_setmetatable(L, -2);
+			return 1;
+		}
+
+		static span_view<_Ty> make_default() noexcept
+		{
+			return span_view<_Ty>();
+		}
+	};
+
+	template <class _Ty>
+	struct type_traits<const span_view<_Ty>&> : type_traits<span_view<_Ty>>
+	{
+
+	};
+}
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus
+//  File name:   table_traits.h
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace luabind
+{
+	template <class _Class, class _Type>
+	struct table_field
+	{
+		static_assert(type_traits<_Type>::stack_count == 1, "wrong type for table field.");
+
+		const char* name;
+		_Type _Class::* member;
+		_Type value;
+		bool has_default;
+	};
+
+	template <class _Class, class _Type>
+	table_field<_Class, _Type> field(const char* name, _Type _Class::* member) noexcept
+	{
+		return { name, member, _Type(), false };
+	}
+
+	template <class _Class, class _Type, class _Val>
+	table_field<_Class, _Type> field(const char* name, _Type _Class::* member, _Val&& value) noexcept
+	{
+		return { name, member, _Type(std::forward<_Val>(value)), true };
+	}
+
+	namespace detail
+	{
+		template <class _Ty, class _Seq>
+		struct table_codec;
+
+		template <class _Ty, size_t... _Idx>
+		struct table_codec<_Ty, std::index_sequence<_Idx...>>
+		{
+			typedef typename std::decay<decltype(table_layout<_Ty>::fields())>::type layout_type;
+
+			static constexpr int field_count = (int)sizeof...(_Idx);
+
+			static const layout_type& layout() noexcept
+			{
+				static const layout_type fields = table_layout<_Ty>::fields();
+				return fields;
+			}
+
+			static int push_keys(lua_State* L) noexcept
+			{
+				static const char key = 0;
+				lua_pushlightuserdata(L, (void*)&key);
+				lua_rawget(L, LUA_REGISTRYINDEX);
+				if (lua_type(L, -1) != LUA_TTABLE)
+				{
+					lua_pop(L, 1);
+					lua_createtable(L, field_count, 0);
+					const char* names[] = { nullptr, std::get<_Idx>(layout()).name... };
+					for (int i = 1; i <= field_count; ++i)
+					{
+						lua_pushstring(L, names[i]);
+						lua_rawseti(L, -2, i);
+					}
+					lua_pushlightuserdata(L, (void*)&key);
+					lua_pushvalue(L, -2);
+					lua_rawset(L, LUA_REGISTRYINDEX);
+				}
+				return lua_gettop(L);
+			}
+
+			template <class _Class, class _Type>
+			static bool test_field(lua_State* L, int t, int k, int i, const table_field<_Class, _Type>& f) noexcept
+			{
+				lua_rawgeti(L, k, i);
+				lua_rawget(L, t);
+				bool res = lua_isnil(L, -1) ? f.has_default : type_traits<_Type>::test(L, -1);
+				lua_pop(L, 1);
+				return res;
+			}
+
+			template <class _Class, class _Type>
+			static bool get_field(lua_State* L, int t, int k, int i, const table_field<_Class, _Type>& f, _Ty& val) noexcept
+			{
+				lua_rawgeti(L, k, i);
+				lua_rawget(L, t);
+				if (!lua_isnil(L, -1))
+				{
+					val.*f.member = type_traits<_Type>::get(L, -1);
+				}
+				else if (f.has_default)
+				{
+					val.*f.member = f.value;
+				}
+				lua_pop(L, 1);
+				return true;
+			}
+
+			template <class _Class, class _Type>
+			static bool push_field(lua_State* L, int i, const table_field<_Class, _Type>& f, const _Ty& val) noexcept
+			{
+				lua_rawgeti(L, -1, i);
+				if (type_traits<_Type>::push(L, val.*f.member) == 1)
+				{
+					lua_rawset(L, -4);
+				}
+				else
+				{
+					lua_pop(L, 1);
+				}
+				return true;
+			}
+
+			template <class _Class, class _Type>
+			static bool set_default(const table_field<_Class, _Type>& f, _Ty& val) noexcept
+			{
+				if (f.has_default)
+				{
+					val.*f.member = f.value;
+				}
+				return true;
+			}
+
+			static bool test(lua_State* L, int t) noexcept
+			{
+				int k = push_keys(L);
+				const bool results[] = { true, test_field(L, t, k, (int)_Idx + 1, std::get<_Idx>(layout()))... };
+				(void)k;
+				for (bool res : results)
+				{
+					if (!res) return false;
+				}
+				return true;
+			}
+
+			static void get(lua_State* L, int t, _Ty& val) noexcept
+			{
+				int k = push_keys(L);
+				const bool results[] = { true, get_field(L, t, k, (int)_Idx + 1, std::get<_Idx>(layout()), val)... };
+				(void)k;
+				(void)results;
+			}
+
+			static void push(lua_State* L, const _Ty& val) noexcept
+			{
+				lua_createtable(L, 0, field_count);
+				push_keys(L);
+				const bool results[] = { true, push_field(L, (int)_Idx + 1, std::get<_Idx>(layout()), val)... };
+				(void)results;
+				lua_pop(L, 1);
+			}
+
+			static _Ty make_default() noexcept
+			{
+				_Ty val = _Ty();
+				const bool results[] = { true, set_default(std::get<_Idx>(layout()), val)... };
+				(void)results;
+				return val;
+			}
+		};
+	}
+
+	template <class _Ty>
+	struct table_traits
+	{
+		typedef detail::table_codec<_Ty, std::make_index_sequence<
+			std::tuple_size<typename std::decay<decltype(table_layout<_Ty>::fields())>::type>::value>> codec;
+
+		static constexpr bool can_get = true;
+
+		static constexpr bool can_push = true;
+
+		static constexpr int stack_count = 1;
+
+		static bool test(lua_State* L, int idx) noexcept
+		{
+			if (lua_type(L, idx) != LUA_TTABLE) return false;
+			LUABIND_HOLD_STACK(L);
+			return codec::test(L, detail::abs_index(L, idx));
+		}
+
+		static _Ty get(lua_State* L, int idx) noexcept
+		{
+			if (lua_type(L, idx) != LUA_TTABLE) return codec::make_default();
+			_Ty val = _Ty();
+			LUABIND_HOLD_STACK(L);
+			codec::get(L, detail::abs_index(L, idx), val);
+			return val;
+		}
+
+		static int push(lua_State* L, const _Ty& val) noexcept
+		{
+			codec::push(L, val);
+			return 1;
+		}
+
+		static _Ty make_default() noexcept
+		{
+			return codec::make_default();
+		}
+	};
+}
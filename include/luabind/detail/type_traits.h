@@ -32,6 +32,12 @@
 
 #include <type_traits>
 #include <tuple>
+#include <utility>
+#include <string>
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+#	include <string_view>
+#	define LUABIND_HAS_STRING_VIEW
+#endif
 
 namespace luabind
 {
@@ -175,6 +181,54 @@ namespace luabind
 	template <class _Ty>
 	struct object_traits;
 
+	template <class _Ty>
+	struct table_layout
+	{
+
+	};
+
+	template <class _Ty>
+	struct table_traits;
+
+	namespace detail
+	{
+		template <class _Ty>
+		struct table_value
+		{
+			typedef typename std::remove_cv<_Ty>::type type;
+		};
+
+		template <class _Ty>
+		struct table_value<const _Ty&>
+		{
+			typedef typename std::remove_cv<_Ty>::type type;
+		};
+
+		template <class _Ty>
+		struct table_value<_Ty&>
+		{
+			typedef void type;
+		};
+
+		template <class _Ty>
+		struct table_value<_Ty&&>
+		{
+			typedef void type;
+		};
+
+		template <class _Ty, class = void>
+		struct has_table_layout : std::false_type
+		{
+
+		};
+
+		template <class _Ty>
+		struct has_table_layout<_Ty, decltype((void)table_layout<_Ty>::fields())> : std::true_type
+		{
+
+		};
+	}
+
 	template <class _Ty>
 	struct value_traits
 	{
@@ -188,7 +242,9 @@ namespace luabind
 	template <class _Ty>
 	struct type_traits : std::conditional < std::is_enum<_Ty>::value,
 		enum_traits<_Ty>, typename std::conditional < std::is_arithmetic<_Ty>::value,
-		number_traits<_Ty>, object_traits<_Ty>>::type>::type
+		number_traits<_Ty>, typename std::conditional < detail::has_table_layout<
+		typename detail::table_value<_Ty>::type>::value,
+		table_traits<typename detail::table_value<_Ty>::type>, object_traits<_Ty>>::type>::type>::type
 	{
 
 	};
@@ -281,7 +337,7 @@ namespace luabind
 	};
 
 	template <>
-	struct type_traits<void*>
+	struct type_traits<std::string>
 	{
 		static constexpr bool can_get = true;
 
@@ -291,28 +347,47 @@ namespace luabind
 
 		static bool test(lua_State* L, int idx) noexcept
 		{
-			return lua_type(L, idx) == LUA_TLIGHTUSERDATA;
+			return (lua_type(L, idx) == LUA_TSTRING);
 		}
 
-		static void* get(lua_State* L, int idx) noexcept
+		static std::string get(lua_State* L, int idx) noexcept
 		{
-			return lua_touserdata(L, idx);
+			size_t len;
+			const char* str = lua_tolstring(L, idx, &len);
+			return std::string(str, len);
 		}
 
-		static int push(lua_State* L, void* val) noexcept
+		static int push(lua_State* L, const std::string& val) noexcept
 		{
-			lua_pushlightuserdata(L, val);
+			lua_pushlstring(L, val.data(), val.size());
 			return 1;
 		}
 
-		static void* make_default() noexcept
+		static std::string make_default() noexcept
 		{
-			return nullptr;
+			return std::string();
 		}
 	};
 
-	template <class _Der, class _Type>
-	struct type_traits<_Type _Der::*>
+	template <>
+	struct type_traits<const std::string> : type_traits<std::string>
+	{
+
+	};
+
+	template <>
+	struct type_traits<const std::string&> : type_traits<std::string>
+	{
+		static const std::string& make_default() noexcept
+		{
+			static const std::string empty;
+			return empty;
+		}
+	};
+
+#	ifdef LUABIND_HAS_STRING_VIEW
+	template <>
+	struct type_traits<std::string_view>
 	{
 		static constexpr bool can_get = true;
 
@@ -322,44 +397,38 @@ namespace luabind
 
 		static bool test(lua_State* L, int idx) noexcept
 		{
-			if (lua_type(L, idx) == LUA_TSTRING)
-			{
-				size_t len;
-				lua_tolstring(L, idx, &len);
-				return len = sizeof(_Type _Der::*);
-			}
-			return false;
+			return (lua_type(L, idx) == LUA_TSTRING);
 		}
 
-		static _Type _Der::* get(lua_State* L, int idx) noexcept
+		static std::string_view get(lua_State* L, int idx) noexcept
 		{
-			union
-			{
-				_Type _Der::* v;
-				char str[sizeof(_Type _Der::*)];
-			};
-			memcpy(str, lua_tostring(L, idx), sizeof(_Type _Der::*));
-			return v;
+			size_t len;
+			const char* str = lua_tolstring(L, idx, &len);
+			return std::string_view(str, len);
 		}
 
-		static int push(lua_State* L, _Type _Der::* val) noexcept
+		static int push(lua_State* L, std::string_view val) noexcept
 		{
-			union
-			{
-				_Type _Der::* v;
-				char str[sizeof(_Type _Der::*)];
-			};
-			v = val;
-			lua_pushlstring(L, str, sizeof(_Type _Der::*));
+			lua_pushlstring(L, val.data(), val.size());
 			return 1;
 		}
+
+		static std::string_view make_default() noexcept
+		{
+			return std::string_view();
+		}
 	};
 
-	template <class _Der, class _Type>
-	struct type_traits<_Type(_Der::*)()>
+	template <>
+	struct type_traits<const std::string_view> : type_traits<std::string_view>
 	{
-		typedef _Type(_Der::*func_type)();
 
+	};
+#	endif
+
+	template <>
+	struct type_traits<void*>
+	{
 		static constexpr bool can_get = true;
 
 		static constexpr bool can_push = true;
@@ -368,39 +437,77 @@ namespace luabind
 
 		static bool test(lua_State* L, int idx) noexcept
 		{
-			if (lua_type(L, idx) == LUA_TSTRING)
+			return lua_type(L, idx) == LUA_TLIGHTUSERDATA;
+		}
+
+		static void* get(lua_State* L, int idx) noexcept
+		{
+			return lua_touserdata(L, idx);
+		}
+
+		static int push(lua_State* L, void* val) noexcept
+		{
+			lua_pushlightuserdata(L, val);
+			return 1;
+		}
+
+		static void* make_default() noexcept
+		{
+			return nullptr;
+		}
+	};
+
+	template <class _Ty>
+	struct member_pointer_traits
+	{
+		static constexpr bool can_get = true;
+
+		static constexpr bool can_push = true;
+
+		static constexpr int stack_count = 1;
+
+		static bool test(lua_State* L, int idx) noexcept
+		{
+			if (lua_type(L, idx) == LUA_TUSERDATA)
 			{
-				size_t len;
-				lua_tolstring(L, idx, &len);
-				return len = sizeof(func_type);
+				if (lua_getmetatable(L, idx))
+				{
+					lua_pop(L, 1);
+					return false;
+				}
+#				if (LUA_VERSION_NUM >= 502)
+				return lua_rawlen(L, idx) == sizeof(_Ty);
+#				else
+				return lua_objlen(L, idx) == sizeof(_Ty);
+#				endif
 			}
 			return false;
 		}
 
-		static func_type get(lua_State* L, int idx) noexcept
+		static _Ty get(lua_State* L, int idx) noexcept
 		{
-			union
-			{
-				func_type f;
-				char str[sizeof(func_type)];
-			};
-			memcpy(str, lua_tostring(L, idx), sizeof(func_type));
-			return f;
+			return *(_Ty*)lua_touserdata(L, idx);
 		}
 
-		static int push(lua_State* L, func_type func) noexcept
+		static int push(lua_State* L, _Ty val) noexcept
 		{
-			union
-			{
-				func_type f;
-				char str[sizeof(func_type)];
-			};
-			f = func;
-			lua_pushlstring(L, str, sizeof(func_type));
+			*(_Ty*)lua_newuserdata(L, sizeof(_Ty)) = val;
 			return 1;
 		}
 	};
 
+	template <class _Der, class _Type>
+	struct type_traits<_Type _Der::*> : member_pointer_traits<_Type _Der::*>
+	{
+
+	};
+
+	template <class _Der, class _Type>
+	struct type_traits<_Type(_Der::*)()> : member_pointer_traits<_Type(_Der::*)()>
+	{
+
+	};
+
 	template <>
 	struct type_traits<lua_CFunction>
 	{
@@ -496,113 +603,171 @@ namespace luabind
 
 	};
 
-	template <int idx, class... _Rest>
-	struct tuple_pusher;
-
-	template <int idx, class... _Rest>
-	struct tuple_real_pusher
+	template <size_t idx, class... _Types>
+	struct stack_offset : std::integral_constant<int, 0>
 	{
-		static int push(lua_State *L, std::tuple<_Rest...> tuple) noexcept
-		{
-			auto val = std::get<idx>(tuple);
-			int i = type_traits<decltype(val)>::push(L, val);
-			if (i >= 0)
-			{
-				int j = tuple_pusher<idx + 1, _Rest...>::push(L, tuple);
-				if (j >= 0)
-				{
-					return i + j;
-				}
-			}
-			return -1;
-		}
-	};
 
-	template <class... _Rest>
-	struct tuple_none_pusher
-	{
-		static int push(lua_State *L, std::tuple<_Rest...> tuple) noexcept
-		{
-			return 0;
-		}
 	};
 
-	template <int idx, class... _Rest>
-	struct tuple_pusher : std::conditional<(idx < sizeof...(_Rest)),
-		tuple_real_pusher<idx, _Rest...>, tuple_none_pusher<_Rest...>>::type
+	template <size_t idx, class _This, class... _Rest>
+	struct stack_offset<idx, _This, _Rest...> : std::integral_constant<int, idx ?
+		(type_traits<_This>::stack_count + stack_offset<(idx ? idx - 1 : 0), _Rest...>::value) : 0>
 	{
 
 	};
 
-	template <class... _Types>
-	struct type_traits<std::tuple<_Types...>>;
+	template <class _Tuple, class _Seq, class... _Types>
+	struct tuple_converter;
 
-	template <>
-	struct type_traits<std::tuple<>>
+	template <class _Tuple, size_t... _Idx, class... _Types>
+	struct tuple_converter<_Tuple, std::index_sequence<_Idx...>, _Types...>
 	{
-		static constexpr bool can_get = true;
+		static constexpr bool can_get = can_get_pak<_Types...>::value;
 
-		static constexpr bool can_push = true;
+		static constexpr bool can_push = can_push_pak<_Types...>::value;
 
-		static constexpr int stack_count = 0;
+		static constexpr int stack_count = stack_offset<sizeof...(_Types), _Types...>::value;
 
 		static bool test(lua_State *L, int idx) noexcept
 		{
+			const bool results[] = { true, type_traits<_Types>::test(L,
+				idx + stack_offset<_Idx, _Types...>::value)... };
+			for (bool res : results)
+			{
+				if (!res) return false;
+			}
 			return true;
 		}
 
-		static std::tuple<> get(lua_State *L, int idx) noexcept
+		static _Tuple get(lua_State *L, int idx) noexcept
 		{
-			return std::tuple<>();
+			return _Tuple(type_traits<_Types>::get(L, idx + stack_offset<_Idx, _Types...>::value)...);
 		}
 
-		static int push(lua_State *L, std::tuple<>) noexcept
+		template <class _Val>
+		static int push(lua_State *L, _Val&& val) noexcept
 		{
-			return 0;
+			const int counts[] = { 0, type_traits<typename std::decay<_Types>::type>::push(
+				L, std::get<_Idx>(std::forward<_Val>(val)))... };
+			int total = 0;
+			for (int count : counts)
+			{
+				if (count < 0) return -1;
+				total += count;
+			}
+			return total;
 		}
 
-		static std::tuple<> make_default() noexcept
+		static _Tuple make_default() noexcept
 		{
-			return std::tuple<>();
+			return _Tuple(type_traits<_Types>::make_default()...);
 		}
 	};
 
-	template <class _This, class... _Rest>
-	struct type_traits<std::tuple<_This, _Rest...>>
+	template <class... _Types>
+	struct tuple_traits : tuple_converter<std::tuple<_Types...>,
+		std::index_sequence_for<_Types...>, _Types...>
 	{
-		static constexpr bool can_get = can_get_pak<_This, _Rest...>::value;
+		typedef std::tuple<_Types...> tuple;
 
-		static constexpr bool can_push = can_push_pak<_This, _Rest...>::value;
+		static int push(lua_State *L, const tuple& val) noexcept
+		{
+			return tuple_traits::tuple_converter::push(L, val);
+		}
 
-		static constexpr int stack_count = type_traits<_This>::stack_count + type_traits<std::tuple<_Rest...>>::stack_count;
+		static int push(lua_State *L, tuple&& val) noexcept
+		{
+			return tuple_traits::tuple_converter::push(L, std::move(val));
+		}
+	};
 
-		static bool test(lua_State *L, int idx) noexcept
+	template <class... _Types>
+	struct yield_result
+	{
+		std::tuple<_Types...> values;
+	};
+
+	template <class _Ty>
+	struct is_yield_result : std::false_type
+	{
+
+	};
+
+	template <class... _Types>
+	struct is_yield_result<yield_result<_Types...>> : std::true_type
+	{
+
+	};
+
+	template <class... _Types>
+	yield_result<typename std::decay<_Types>::type...> make_yield(_Types&&... pak) noexcept
+	{
+		return { std::tuple<typename std::decay<_Types>::type...>(std::forward<_Types>(pak)...) };
+	}
+
+	template <class _First, class _Second>
+	struct pair_traits : tuple_converter<std::pair<_First, _Second>,
+		std::index_sequence<0, 1>, _First, _Second>
+	{
+		typedef std::pair<_First, _Second> pair;
+
+		static int push(lua_State *L, const pair& val) noexcept
 		{
-			if (type_traits<_This>::test(L, idx))
-			{
-				return type_traits<std::tuple<_Rest...>>::test(L, idx + type_traits<_This>::stack_count);
-			}
-			return false;
+			return pair_traits::tuple_converter::push(L, val);
 		}
 
-		static std::tuple<_This, _Rest...> get(lua_State *L, int idx) noexcept
+		static int push(lua_State *L, pair&& val) noexcept
 		{
-			return std::tuple_cat(std::make_tuple(type_traits<_This>::get(L, idx)),
-				type_traits<std::tuple<_Rest...>>::get(L, idx + type_traits<_This>::stack_count));
+			return pair_traits::tuple_converter::push(L, std::move(val));
 		}
+	};
 
-		static int push(lua_State *L, std::tuple<_This, _Rest...> val) noexcept
+	template <class... _Types>
+	struct type_traits<std::tuple<_Types...>> : tuple_traits<_Types...>
+	{
+
+	};
+
+	template <class... _Types>
+	struct type_traits<const std::tuple<_Types...>&> : tuple_traits<_Types...>
+	{
+
+	};
+
+	template <class... _Types>
+	struct type_traits<yield_result<_Types...>>
+	{
+		typedef yield_result<_Types...> result;
+
+		static constexpr bool can_get = false;
+
+		static constexpr bool can_push = tuple_traits<_Types...>::can_push;
+
+		static constexpr int stack_count = tuple_traits<_Types...>::stack_count;
+
+		static int push(lua_State* L, const result& val) noexcept
 		{
-			return tuple_pusher<0, _This, _Rest...>::push(L, val);
+			return tuple_traits<_Types...>::push(L, val.values);
 		}
 
-		static std::tuple<_This, _Rest...> make_default() noexcept
+		static int push(lua_State* L, result&& val) noexcept
 		{
-			return std::tuple_cat(std::make_tuple(type_traits<_This>::make_default()),
-				type_traits<std::tuple<_Rest...>>::make_default());
+			return tuple_traits<_Types...>::push(L, std::move(val.values));
 		}
 	};
 
+	template <class _First, class _Second>
+	struct type_traits<std::pair<_First, _Second>> : pair_traits<_First, _Second>
+	{
+
+	};
+
+	template <class _First, class _Second>
+	struct type_traits<const std::pair<_First, _Second>&> : pair_traits<_First, _Second>
+	{
+
+	};
+
 	template <class... _Types>
 	struct params_traits;
 
@@ -615,7 +780,8 @@ namespace luabind
 	template <class _This, class... _Rest>
 	struct params_traits<_This, _Rest...>
 	{
-		static constexpr int stack_count = type_traits<_This>::stack_count + params_traits<_Rest...>::stack_count;
+		static constexpr int stack_count = type_traits<typename std::decay<_This>::type>::stack_count
+			+ params_traits<_Rest...>::stack_count;
 	};
 
 
@@ -634,12 +800,12 @@ namespace luabind
 	template <class _This, class... _Rest>
 	struct params_pusher<_This, _Rest...>
 	{
-		static int push(lua_State *L, _This val, _Rest... pak) noexcept
+		static int push(lua_State *L, _This&& val, _Rest&&... pak) noexcept
 		{
-			int i = type_traits<_This>::push(L, val);
+			int i = type_traits<typename std::decay<_This>::type>::push(L, std::forward<_This>(val));
 			if (i >= 0)
 			{
-				int j = params_pusher<_Rest...>::push(L, pak...);
+				int j = params_pusher<_Rest...>::push(L, std::forward<_Rest>(pak)...);
 				if (j >= 0)
 				{
 					return i + j;
@@ -41,6 +41,12 @@ namespace luabind
 			top = lua_gettop(_L);
 		}
 
+		holder(lua_State* _L, int _top) noexcept
+			: L(_L), top(_top)
+		{
+
+		}
+
 		~holder() noexcept
 		{
 			lua_settop(L, top);
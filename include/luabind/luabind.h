@@ -54,6 +54,26 @@
 #define LB_BUF_SIZE (1024)
 #endif
 
+//5.3+ only and opt-in: caches the env in LUA_EXTRASPACE so get_env is a single
+//load. Lua 5.3 leaves the main thread extra space uninitialised, so every state
+//has to be zeroed before first use (pool_allocator::new_state does it). When
+//off, get_env is a registry lookup.
+#ifndef LB_ENV_EXTRASPACE
+#define LB_ENV_EXTRASPACE (0)
+#endif
+
+#ifndef LB_POOL_GRANULARITY
+#define LB_POOL_GRANULARITY (16)
+#endif
+
+#ifndef LB_POOL_MAX_SIZE
+#define LB_POOL_MAX_SIZE (256)
+#endif
+
+#ifndef LB_POOL_SLAB_SIZE
+#define LB_POOL_SLAB_SIZE (16384)
+#endif
+
 #ifndef NDEBUG
 #define LB_ASSERT_EQ(e,v) LB_ASSERT(e == v)
 #else
@@ -63,6 +83,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "detail/utility.h"
+#include "detail/allocator.h"
 #include "detail/type_traits.h"
 #include "detail/environment.h"
 #include "detail/invoke.h"
@@ -71,6 +92,9 @@
 #include "detail/scope.h"
 #include "detail/class.h"
 #include "detail/object_traits.h"
+#include "detail/container_traits.h"
+#include "detail/table_traits.h"
+#include "detail/span.h"
 #include "detail/enum.h"
 
 namespace luabind
@@ -103,3 +127,19 @@ namespace luabind
 #ifdef LB_BUF_SIZE
 #undef LB_BUF_SIZE
 #endif
+
+#ifdef LB_ENV_EXTRASPACE
+#undef LB_ENV_EXTRASPACE
+#endif
+
+#ifdef LB_POOL_GRANULARITY
+#undef LB_POOL_GRANULARITY
+#endif
+
+#ifdef LB_POOL_MAX_SIZE
+#undef LB_POOL_MAX_SIZE
+#endif
+
+#ifdef LB_POOL_SLAB_SIZE
+#undef LB_POOL_SLAB_SIZE
+#endif
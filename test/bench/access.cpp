@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   access.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	struct Base
+	{
+		int b = 1;
+	};
+
+	struct Point : Base
+	{
+		int x = 1;
+		int y = 2;
+
+		int get_x() noexcept
+		{
+			return x;
+		}
+
+		bool set_y(int v) noexcept
+		{
+			y = v;
+			return true;
+		}
+	};
+
+	struct FlatPoint : Point
+	{
+
+	};
+
+	int value = 1;
+
+	int get_value() noexcept
+	{
+		return value;
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "access")
+		[
+			def("value", value),
+			def_reader("value_reader", &get_value),
+			class_<Base>("Base")
+				.def("b", &Base::b),
+			class_<Point, Base>("Point")
+				.def(constructor<>())
+				.def("x", &Point::x)
+				.def("y", &Point::y)
+				.def<decltype(&Point::x), &Point::x>("bx")
+				.def_reader("gx", &Point::get_x)
+				.def_writer("sy", &Point::set_y),
+			class_<FlatPoint, Point>("FlatPoint", CLASS_FLATTEN)
+				.def(constructor<>())
+		];
+	}
+
+	const bench_case cases[] =
+	{
+		{ "loop", "s = s + i" },
+		{ "read_member", "s = s + p.x" },
+		{ "write_member", "p.x = i" },
+		{ "read_bound_member", "s = s + p.bx" },
+		{ "write_bound_member", "p.bx = i" },
+		{ "read_reader", "s = s + p.gx" },
+		{ "write_writer", "p.sy = i" },
+		{ "read_base_member", "s = s + p.b" },
+		{ "write_base_member", "p.b = i" },
+		{ "flat_read_base_member", "s = s + f.b" },
+		{ "flat_write_base_member", "f.b = i" },
+		{ "read_namespace_value", "s = s + access.value" },
+		{ "write_namespace_value", "access.value = i" },
+		{ "read_namespace_reader", "s = s + access.value_reader" },
+	};
+}
+
+BENCH_SUITE(access, &bind,
+	"local p, f = access.Point(), access.FlatPoint()", cases);
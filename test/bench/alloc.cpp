@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   alloc.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	struct Particle
+	{
+		double x = 0;
+		double y = 0;
+		int life = 0;
+	};
+
+	std::shared_ptr<Particle> spawn(int life) noexcept
+	{
+		auto p = std::make_shared<Particle>();
+		p->life = life;
+		return p;
+	}
+
+	void bind(lua_State*) noexcept
+	{
+
+	}
+
+	void bind_churn(lua_State* L) noexcept
+	{
+		luaL_openlibs(L);
+		module(L, "alloc")
+		[
+			class_<Particle>("Particle")
+				.def(constructor<>())
+				.def("x", &Particle::x)
+				.def("life", &Particle::life),
+			def("spawn", &spawn)
+		];
+	}
+
+	void churn(lua_State* L, const char* body, int n) noexcept
+	{
+		bind_churn(L);
+		std::string code = "local Particle, spawn = alloc.Particle, alloc.spawn return function(n) local s = 0 for i = 1, n do ";
+		code += body;
+		code += " end return s end";
+		if (luaL_dostring(L, code.c_str()))
+		{
+			fprintf(stderr, "alloc: %s\n", lua_tostring(L, -1));
+			exit(1);
+		}
+		lua_pushinteger(L, n);
+		if (lua_pcall(L, 1, 1, 0))
+		{
+			fprintf(stderr, "alloc: %s\n", lua_tostring(L, -1));
+			exit(1);
+		}
+		bench_sink = lua_tonumber(L, -1);
+		lua_close(L);
+	}
+
+	const char* objects_body = "local p = Particle() p.life = i s = s + p.life";
+
+	const char* shared_body = "s = s + spawn(i).life";
+
+	const char* tables_body = "local t = { x = i, y = i, tostring(i) } s = s + t.x";
+
+	void default_objects(lua_State*, int n) noexcept
+	{
+		churn(luaL_newstate(), objects_body, n);
+	}
+
+	void pool_objects(lua_State*, int n) noexcept
+	{
+		pool_allocator pool;
+		churn(pool.new_state(), objects_body, n);
+	}
+
+	void default_shared(lua_State*, int n) noexcept
+	{
+		churn(luaL_newstate(), shared_body, n);
+	}
+
+	void pool_shared(lua_State*, int n) noexcept
+	{
+		pool_allocator pool;
+		churn(pool.new_state(), shared_body, n);
+	}
+
+	void default_tables(lua_State*, int n) noexcept
+	{
+		churn(luaL_newstate(), tables_body, n);
+	}
+
+	void pool_tables(lua_State*, int n) noexcept
+	{
+		pool_allocator pool;
+		churn(pool.new_state(), tables_body, n);
+	}
+
+	const bench_case cases[] =
+	{
+		{ "default_objects", nullptr, &default_objects },
+		{ "pool_objects", nullptr, &pool_objects },
+		{ "default_shared", nullptr, &default_shared },
+		{ "pool_shared", nullptr, &pool_shared },
+		{ "default_tables", nullptr, &default_tables },
+		{ "pool_tables", nullptr, &pool_tables },
+	};
+}
+
+BENCH_SUITE(alloc, &bind, nullptr, cases);
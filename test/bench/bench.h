@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   bench.h
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+extern "C"
+{
+#	include <lua.h>
+#	include <lualib.h>
+#	include <lauxlib.h>
+}
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#define LB_ASSERT assert
+#define LB_LOG_W printf
+#define LB_LOG_E printf
+#include <vtd/intrusive_ptr.h>
+namespace luabind
+{
+	template <class _Ty>
+	struct intrusive_obj : vtd::intrusive_obj<_Ty>
+	{
+
+	};
+}
+#include <luabind/luabind.h>
+
+struct bench_case
+{
+	const char* name;
+	const char* body;
+	void(*native)(lua_State* L, int n);
+	int cost;
+};
+
+struct bench_suite
+{
+	bench_suite(const char* n, void(*b)(lua_State*), const char* p,
+		const bench_case* c, size_t count) noexcept
+		: name(n), bind(b), prelude(p), cases(c), case_count(count)
+	{
+		list().push_back(this);
+	}
+
+	static std::vector<bench_suite*>& list() noexcept
+	{
+		static std::vector<bench_suite*> suites;
+		return suites;
+	}
+
+	const char* name;
+	void(*bind)(lua_State*);
+	const char* prelude;
+	const bench_case* cases;
+	size_t case_count;
+};
+
+#define BENCH_SUITE(name, bind, prelude, cases) \
+	static bench_suite bench_suite_##name(#name, bind, prelude, \
+		cases, sizeof(cases) / sizeof(cases[0]))
+
+extern volatile lua_Number bench_sink;
+
+struct bench_tracked_counts
+{
+	size_t copies = 0;
+	size_t moves = 0;
+};
+
+extern bench_tracked_counts bench_tracked;
+
+inline int bench_registry_size(lua_State* L) noexcept
+{
+	int live = 0;
+	for (size_t count : luabind::get_env(L)->ref_counts)
+	{
+		if (count) ++live;
+	}
+	return live;
+}
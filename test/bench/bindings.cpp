@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   bindings.cpp
+//  Created:     2026/10/18 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	struct Unit
+	{
+		int hp = 100;
+		int mp = 50;
+		float x = 0;
+		float y = 0;
+
+		void move(float dx, float dy) noexcept
+		{
+			x += dx;
+			y += dy;
+		}
+
+		int damage(int v) noexcept
+		{
+			hp -= v;
+			return hp;
+		}
+	};
+
+	int tick = 0;
+
+	int add(int a, int b) noexcept
+	{
+		return a + b;
+	}
+
+	double scale(double a) noexcept
+	{
+		return a * 2;
+	}
+
+	template <int N>
+	struct Many
+	{
+		int a = N;
+
+		int get() noexcept
+		{
+			return a;
+		}
+	};
+
+	const char* many_names[] =
+	{
+		"C0", "C1", "C2", "C3", "C4", "C5", "C6", "C7",
+		"C8", "C9", "C10", "C11", "C12", "C13", "C14", "C15",
+		"C16", "C17", "C18", "C19", "C20", "C21", "C22", "C23",
+		"C24", "C25", "C26", "C27", "C28", "C29", "C30", "C31",
+	};
+
+	template <int N>
+	struct many_scope
+	{
+		static scope make(int flags) noexcept
+		{
+			return (many_scope<N - 1>::make(flags),
+				class_<Many<N>>(many_names[N], flags)
+					.def(constructor<>())
+					.def("a", &Many<N>::a)
+					.def("get", &Many<N>::get));
+		}
+	};
+
+	template <>
+	struct many_scope<0>
+	{
+		static scope make(int flags) noexcept
+		{
+			return class_<Many<0>>(many_names[0], flags)
+				.def(constructor<>())
+				.def("a", &Many<0>::a)
+				.def("get", &Many<0>::get);
+		}
+	};
+
+	void bind(lua_State*) noexcept
+	{
+
+	}
+
+	scope make_scope() noexcept
+	{
+		return (
+			class_<Unit>("Unit")
+				.def(constructor<>())
+				.def("hp", &Unit::hp)
+				.def("mp", &Unit::mp)
+				.def("x", &Unit::x)
+				.def("y", &Unit::y)
+				.def("move", &Unit::move)
+				.def("damage", &Unit::damage),
+			namespace_("math")
+			[
+				def("add", &add),
+				def("scale", &scale)
+			],
+			def("tick", tick),
+			def_const("version", 3)
+		);
+	}
+
+	binding_set& shared_set() noexcept
+	{
+		static binding_set set("bindings");
+		static bool init = [&]() noexcept
+		{
+			set[make_scope()];
+			return true;
+		}();
+		(void)init;
+		return set;
+	}
+
+	void state_only(lua_State*, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			lua_close(luaL_newstate());
+		}
+	}
+
+	void module_per_state(lua_State*, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			lua_State* L = luaL_newstate();
+			module(L, "bindings")[make_scope()];
+			lua_close(L);
+		}
+	}
+
+	void binding_set_per_state(lua_State*, int n) noexcept
+	{
+		binding_set& set = shared_set();
+		for (int i = 0; i < n; ++i)
+		{
+			lua_State* L = luaL_newstate();
+			set.instantiate(L);
+			lua_close(L);
+		}
+	}
+
+	void many_classes(int flags, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			lua_State* L = luaL_newstate();
+			module(L, "many")[many_scope<31>::make(flags)];
+			if (luaL_dostring(L, "return many.C1().a + many.C2():get()"))
+			{
+				fprintf(stderr, "bindings: %s\n", lua_tostring(L, -1));
+				exit(1);
+			}
+			bench_sink = lua_tonumber(L, -1);
+			lua_close(L);
+		}
+	}
+
+	void eager_32_classes(lua_State*, int n) noexcept
+	{
+		many_classes(CLASS_NORMAL, n);
+	}
+
+	void lazy_32_classes(lua_State*, int n) noexcept
+	{
+		many_classes(CLASS_LAZY, n);
+	}
+
+	const bench_case cases[] =
+	{
+		{ "state_only", nullptr, &state_only, 100 },
+		{ "module_per_state", nullptr, &module_per_state, 100 },
+		{ "binding_set_per_state", nullptr, &binding_set_per_state, 100 },
+		{ "eager_32_classes", nullptr, &eager_32_classes, 1000 },
+		{ "lazy_32_classes", nullptr, &lazy_32_classes, 1000 },
+	};
+}
+
+BENCH_SUITE(bindings, &bind, nullptr, cases);
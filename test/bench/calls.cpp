@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   calls.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+#include <string.h>
+
+using namespace luabind;
+
+namespace
+{
+	struct Base
+	{
+		int b = 1;
+	};
+
+	struct Derived : Base
+	{
+
+	};
+
+	int f0() noexcept
+	{
+		return 0;
+	}
+
+	int f1(int a) noexcept
+	{
+		return a;
+	}
+
+	int f2(int a, int b) noexcept
+	{
+		return a + b;
+	}
+
+	int f3(int a, int b, int c) noexcept
+	{
+		return a + b + c;
+	}
+
+	int f4(int a, int b, int c, int d) noexcept
+	{
+		return a + b + c + d;
+	}
+
+	int f5(int a, int b, int c, int d, int e) noexcept
+	{
+		return a + b + c + d + e;
+	}
+
+	int f6(int a, int b, int c, int d, int e, int f) noexcept
+	{
+		return a + b + c + d + e + f;
+	}
+
+	int f7(int a, int b, int c, int d, int e, int f, int g) noexcept
+	{
+		return a + b + c + d + e + f + g;
+	}
+
+	int f8(int a, int b, int c, int d, int e, int f, int g, int h) noexcept
+	{
+		return a + b + c + d + e + f + g + h;
+	}
+
+	int add1(const char* a) noexcept
+	{
+		return 1;
+	}
+
+	int add2(bool a, bool b) noexcept
+	{
+		return 2;
+	}
+
+	int add3(Base& a, int b) noexcept
+	{
+		return 3;
+	}
+
+	int add4(int a, int b, int c) noexcept
+	{
+		return 4;
+	}
+
+	int add5(const char* a, int b) noexcept
+	{
+		return 5;
+	}
+
+	int add6(int a, int b) noexcept
+	{
+		return a + b;
+	}
+
+	size_t length_cstr(const char* s) noexcept
+	{
+		return strlen(s);
+	}
+
+	size_t length_string(const std::string& s) noexcept
+	{
+		return s.size();
+	}
+
+	std::string echo_string(const std::string& s) noexcept
+	{
+		return s;
+	}
+
+#	ifdef LUABIND_HAS_STRING_VIEW
+	size_t length_view(std::string_view s) noexcept
+	{
+		return s.size();
+	}
+
+	std::string_view echo_view(std::string_view s) noexcept
+	{
+		return s;
+	}
+#	endif
+
+	int base_value(Base& b) noexcept
+	{
+		return b.b;
+	}
+
+	typedef std::tuple<int, int, int, int, int, int> tuple_6;
+
+	tuple_6 make_tuple_6(int a) noexcept
+	{
+		return tuple_6(a, 1, 2, 3, 4, 5);
+	}
+
+	int sum_tuple_6(tuple_6 t) noexcept
+	{
+		return std::get<0>(t) + std::get<5>(t);
+	}
+
+	std::pair<int, double> make_pair_2(int a) noexcept
+	{
+		return std::make_pair(a, 0.5);
+	}
+
+	void call_multi_return(lua_State* L, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = std::get<5>(call_function<tuple_6>(L, "calls.make_tuple_6", i));
+		}
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "calls")
+		[
+			def("f0", &f0),
+			def("f1", &f1),
+			def("f2", &f2),
+			def("f3", &f3),
+			def("f4", &f4),
+			def("f5", &f5),
+			def("f6", &f6),
+			def("f7", &f7),
+			def("f8", &f8),
+			def<decltype(&f0), &f0>("static_f0"),
+			def<decltype(&f2), &f2>("static_f2"),
+			def<decltype(&f8), &f8>("static_f8"),
+			def("default_f4", &f4, 3, 4),
+			def("default_f8", &f8, 3, 4, 5, 6, 7, 8),
+			def("add", &add1),
+			def("add", &add2),
+			def("add", &add3),
+			def("add", &add4),
+			def("add", &add5),
+			def("add", &add6),
+			def("base_value", &base_value),
+			def("make_tuple_6", &make_tuple_6),
+			def("sum_tuple_6", &sum_tuple_6),
+			def("make_pair_2", &make_pair_2),
+			def("length_cstr", &length_cstr),
+			def("length_string", &length_string),
+			def("echo_string", &echo_string),
+#			ifdef LUABIND_HAS_STRING_VIEW
+			def("length_view", &length_view),
+			def("echo_view", &echo_view),
+#			endif
+			class_<Base>("Base")
+				.def(constructor<>()),
+			class_<Derived, Base>("Derived")
+				.def(constructor<>())
+		];
+	}
+
+	const bench_case cases[] =
+	{
+		{ "args_0", "s = s + f0()" },
+		{ "args_1", "s = s + f1(i)" },
+		{ "args_2", "s = s + f2(i, 1)" },
+		{ "args_3", "s = s + f3(i, 1, 2)" },
+		{ "args_4", "s = s + f4(i, 1, 2, 3)" },
+		{ "args_5", "s = s + f5(i, 1, 2, 3, 4)" },
+		{ "args_6", "s = s + f6(i, 1, 2, 3, 4, 5)" },
+		{ "args_7", "s = s + f7(i, 1, 2, 3, 4, 5, 6)" },
+		{ "args_8", "s = s + f8(i, 1, 2, 3, 4, 5, 6, 7)" },
+		{ "static_args_0", "s = s + static_f0()" },
+		{ "static_args_2", "s = s + static_f2(i, 1)" },
+		{ "static_args_8", "s = s + static_f8(i, 1, 2, 3, 4, 5, 6, 7)" },
+		{ "default_args_2_of_4", "s = s + default_f4(i, 1)" },
+		{ "default_args_2_of_8", "s = s + default_f8(i, 1)" },
+		{ "overload_first", "s = s + add('a')" },
+		{ "overload_middle", "s = s + add(b, i)" },
+		{ "overload_last", "s = s + add(i, 1)" },
+		{ "argument_exact", "s = s + base_value(b)" },
+		{ "argument_upcast", "s = s + base_value(d)" },
+		{ "global_lookup", "s = s + calls.f1(i)" },
+		{ "tuple_6_return", "local a, b, c, d, e, f = make_tuple_6(i) s = s + f" },
+		{ "tuple_6_param", "s = s + sum_tuple_6(i, 1, 2, 3, 4, 5)" },
+		{ "pair_return", "local a, b = make_pair_2(i) s = s + b" },
+		{ "tuple_6_call_function", nullptr, &call_multi_return },
+		{ "string_4k_cstr", "s = s + length_cstr(packet)" },
+		{ "string_4k_string", "s = s + length_string(packet)" },
+		{ "string_4k_echo_string", "s = s + #echo_string(packet)" },
+#		ifdef LUABIND_HAS_STRING_VIEW
+		{ "string_4k_view", "s = s + length_view(packet)" },
+		{ "string_4k_echo_view", "s = s + #echo_view(packet)" },
+#		endif
+	};
+}
+
+BENCH_SUITE(calls, &bind,
+	"local f0, f1, f2, f3, f4 = calls.f0, calls.f1, calls.f2, calls.f3, calls.f4 "
+	"local f5, f6, f7, f8 = calls.f5, calls.f6, calls.f7, calls.f8 "
+	"local static_f0, static_f2, static_f8 = calls.static_f0, calls.static_f2, calls.static_f8 "
+	"local default_f4, default_f8 = calls.default_f4, calls.default_f8 "
+	"local add, base_value = calls.add, calls.base_value "
+	"local make_tuple_6, sum_tuple_6, make_pair_2 = calls.make_tuple_6, calls.sum_tuple_6, calls.make_pair_2 "
+	"local b, d = calls.Base(), calls.Derived() "
+	"local length_cstr, length_string, echo_string = calls.length_cstr, calls.length_string, calls.echo_string "
+	"local length_view, echo_view = calls.length_view, calls.echo_view "
+	"local packet = string.rep('x', 4096)", cases);
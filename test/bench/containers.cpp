@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   containers.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	std::vector<double> values(10000, 1.5);
+
+	std::vector<float> samples(1024, 0.5f);
+
+	std::unordered_map<int, float> stats = []() noexcept
+	{
+		std::unordered_map<int, float> m;
+		for (int i = 0; i < 1000; ++i)
+		{
+			m[i * 7] = i * 0.5f;
+		}
+		return m;
+	}();
+
+	std::map<std::string, int> names = { { "alpha", 1 }, { "beta", 2 }, { "gamma", 3 }, { "delta", 4 } };
+
+	std::vector<double> get_values() noexcept
+	{
+		return values;
+	}
+
+	double sum_values(const std::vector<double>& v) noexcept
+	{
+		double s = 0;
+		for (auto d : v)
+		{
+			s += d;
+		}
+		return s;
+	}
+
+	int sum_ints(const std::vector<int>& v) noexcept
+	{
+		int s = 0;
+		for (auto d : v)
+		{
+			s += d;
+		}
+		return s;
+	}
+
+	float sum_array(const std::array<float, 16>& v) noexcept
+	{
+		float s = 0;
+		for (auto d : v)
+		{
+			s += d;
+		}
+		return s;
+	}
+
+	std::unordered_map<int, float> get_stats() noexcept
+	{
+		return stats;
+	}
+
+	size_t count_stats(const std::unordered_map<int, float>& m) noexcept
+	{
+		return m.size();
+	}
+
+	std::map<std::string, int> get_names() noexcept
+	{
+		return names;
+	}
+
+	size_t count_names(const std::map<std::string, int>& m) noexcept
+	{
+		return m.size();
+	}
+
+	span_view<float> get_samples() noexcept
+	{
+		return span_view<float>(samples.data(), samples.size());
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "containers")
+		[
+			def("get_values", &get_values),
+			def("sum_values", &sum_values),
+			def("sum_ints", &sum_ints),
+			def("sum_array", &sum_array),
+			def("get_stats", &get_stats),
+			def("count_stats", &count_stats),
+			def("get_names", &get_names),
+			def("count_names", &count_names),
+			def("get_samples", &get_samples)
+		];
+	}
+
+	const bench_case cases[] =
+	{
+		{ "push_vector_double_10k", "s = s + #get_values()", nullptr, 10000 },
+		{ "get_vector_double_10k", "s = s + sum_values(doubles)", nullptr, 10000 },
+		{ "get_vector_int_10k", "s = s + sum_ints(ints)", nullptr, 10000 },
+		{ "get_array_float_16", "s = s + sum_array(floats)", nullptr, 16 },
+		{ "span_read", "s = s + samples[i % 1024 + 1]" },
+		{ "span_write", "samples[i % 1024 + 1] = i" },
+		{ "span_length", "s = s + #samples" },
+		{ "table_read", "s = s + doubles[i % 1024 + 1]" },
+		{ "push_unordered_map_1k", "s = s + get_stats()[7]", nullptr, 1000 },
+		{ "get_unordered_map_1k", "s = s + count_stats(stat_table)", nullptr, 1000 },
+		{ "push_map_string_4", "s = s + get_names().beta", nullptr, 4 },
+		{ "get_map_string_4", "s = s + count_names(name_table)", nullptr, 4 },
+	};
+}
+
+BENCH_SUITE(containers, &bind,
+	"local get_values, sum_values = containers.get_values, containers.sum_values "
+	"local sum_ints, sum_array = containers.sum_ints, containers.sum_array "
+	"local doubles, ints, floats = {}, {}, {} "
+	"for i = 1, 10000 do doubles[i] = i * 0.5 ints[i] = i end "
+	"for i = 1, 16 do floats[i] = i end "
+	"local get_stats, count_stats = containers.get_stats, containers.count_stats "
+	"local get_names, count_names = containers.get_names, containers.count_names "
+	"local stat_table, name_table = get_stats(), get_names() "
+	"local samples = containers.get_samples()", cases);
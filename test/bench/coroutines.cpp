@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   coroutines.cpp
+//  Created:     2026/10/18 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	int plain(int v) noexcept
+	{
+		return v + 1;
+	}
+
+	yield_result<int> wait(int v) noexcept
+	{
+		return make_yield(v + 1);
+	}
+
+	void call_plain(lua_State* L, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = call_function<int>(L, "coroutines.plain", i);
+		}
+	}
+
+	void resume_wait(lua_State* L, int n) noexcept
+	{
+		lua_State* co = lua_newthread(L);
+		luaL_loadstring(co, "local v = ... while true do v = coroutines.wait(v) end");
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = resume_function<int>(co, i);
+		}
+		lua_pop(L, 1);
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "coroutines")
+		[
+			def("plain", &plain),
+			def("wait", &wait)
+		];
+	}
+
+	const bench_case cases[] =
+	{
+		{ "plain_call", "s = s + plain(i)" },
+		{ "lua_yield", "s = s + lua_gen(i)" },
+		{ "cpp_yield", "s = s + cpp_gen(i)" },
+		{ "call_function", nullptr, &call_plain },
+		{ "resume_function", nullptr, &resume_wait },
+	};
+}
+
+BENCH_SUITE(coroutines, &bind,
+	"local plain, wait = coroutines.plain, coroutines.wait "
+	"local lua_gen = coroutine.wrap(function(v) while true do v = coroutine.yield(v + 1) end end) "
+	"local cpp_gen = coroutine.wrap(function(v) while true do v = wait(v) end end)",
+	cases);
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   main.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+volatile lua_Number bench_sink = 0;
+
+bench_tracked_counts bench_tracked;
+
+struct bench_options
+{
+	int iterations = 2000000;
+	int repeat = 3;
+	bool json = false;
+	const char* filter = nullptr;
+	const char* output = nullptr;
+};
+
+struct bench_result
+{
+	double ns;
+	int registry_growth;
+	double copies;
+	double moves;
+};
+
+static bench_result run_case(lua_State* L, const bench_suite& suite,
+	const bench_case& c, const bench_options& opt) noexcept
+{
+	int registry = bench_registry_size(L);
+	int n = c.cost > 1 ? opt.iterations / c.cost : opt.iterations;
+	if (n < 1) n = 1;
+	if (!c.native)
+	{
+		std::string code = suite.prelude ? suite.prelude : "";
+		code += " return function(n) local s = 0 for i = 1, n do ";
+		code += c.body;
+		code += " end return s end";
+		if (luaL_dostring(L, code.c_str()))
+		{
+			fprintf(stderr, "%s.%s: %s\n", suite.name, c.name, lua_tostring(L, -1));
+			exit(1);
+		}
+	}
+	double best = 0;
+	bench_tracked = bench_tracked_counts();
+	for (int r = 0; r < opt.repeat; ++r)
+	{
+		auto start = std::chrono::steady_clock::now();
+		if (c.native)
+		{
+			c.native(L, n);
+		}
+		else
+		{
+			lua_pushvalue(L, -1);
+			lua_pushinteger(L, n);
+			if (lua_pcall(L, 1, 1, 0))
+			{
+				fprintf(stderr, "%s.%s: %s\n", suite.name, c.name, lua_tostring(L, -1));
+				exit(1);
+			}
+			bench_sink = lua_tonumber(L, -1);
+			lua_pop(L, 1);
+		}
+		auto end = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / n;
+		if (r == 0 || ns < best) best = ns;
+	}
+	if (!c.native)
+	{
+		lua_pop(L, 1);
+	}
+	double ops = (double)n * opt.repeat;
+	return { best, bench_registry_size(L) - registry,
+		bench_tracked.copies / ops, bench_tracked.moves / ops };
+}
+
+int main(int argc, char* argv[])
+{
+	bench_options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--json"))
+		{
+			opt.json = true;
+		}
+		else if (!strcmp(argv[i], "--repeat") && i + 1 < argc)
+		{
+			opt.repeat = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+		{
+			opt.filter = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc)
+		{
+			opt.output = argv[++i];
+		}
+		else
+		{
+			opt.iterations = atoi(argv[i]);
+		}
+	}
+	if (opt.iterations <= 0 || opt.repeat <= 0)
+	{
+		fprintf(stderr, "usage: %s [iterations] [--repeat n] [--filter text] [--json] [--out file]\n", argv[0]);
+		return 1;
+	}
+	FILE* out = opt.output ? fopen(opt.output, "w") : stdout;
+	if (!out)
+	{
+		fprintf(stderr, "can not open %s\n", opt.output);
+		return 1;
+	}
+	std::vector<bench_suite*>& suites = bench_suite::list();
+	std::sort(suites.begin(), suites.end(), [](bench_suite* a, bench_suite* b) noexcept
+	{
+		return strcmp(a->name, b->name) < 0;
+	});
+	lua_State* L = luaL_newstate();
+	luaL_openlibs(L);
+	for (auto suite : suites)
+	{
+		suite->bind(L);
+	}
+	if (opt.json)
+	{
+		fprintf(out, "{\n\t\"lua\": \"%s\",\n\t\"iterations\": %d,\n\t\"repeat\": %d,\n\t\"results\": [",
+			LUA_RELEASE, opt.iterations, opt.repeat);
+	}
+	else
+	{
+		fprintf(out, "%s, %d iterations, best of %d\n", LUA_RELEASE, opt.iterations, opt.repeat);
+	}
+	bool first = true;
+	for (auto suite : suites)
+	{
+		for (size_t i = 0; i < suite->case_count; ++i)
+		{
+			const bench_case& c = suite->cases[i];
+			std::string full = std::string(suite->name) + "." + c.name;
+			if (opt.filter && !strstr(full.c_str(), opt.filter)) continue;
+			bench_result res = run_case(L, *suite, c, opt);
+			if (opt.json)
+			{
+				fprintf(out, "%s\n\t\t{ \"suite\": \"%s\", \"case\": \"%s\", \"ns_per_op\": %.3f, \"registry_growth\": %d, "
+					"\"copies_per_op\": %.2f, \"moves_per_op\": %.2f }",
+					first ? "" : ",", suite->name, c.name, res.ns, res.registry_growth, res.copies, res.moves);
+			}
+			else
+			{
+				fprintf(out, "%-36s %10.2f ns/op", full.c_str(), res.ns);
+				if (res.registry_growth)
+				{
+					fprintf(out, " %6d registry slots", res.registry_growth);
+				}
+				if (res.copies > 0 || res.moves > 0)
+				{
+					fprintf(out, " %6.2f copies %6.2f moves", res.copies, res.moves);
+				}
+				fprintf(out, "\n");
+			}
+			first = false;
+		}
+	}
+	if (opt.json)
+	{
+		fprintf(out, "\n\t]\n}\n");
+	}
+	if (out != stdout)
+	{
+		fclose(out);
+	}
+	lua_close(L);
+	return 0;
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   members.cpp 
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	struct Depth0
+	{
+		int v = 1;
+
+		int get() noexcept
+		{
+			return v;
+		}
+
+		int add(int a, int b) noexcept
+		{
+			return v + a + b;
+		}
+
+		int add_s(const char* a) noexcept
+		{
+			return v;
+		}
+	};
+
+	struct Depth1 : Depth0
+	{
+
+	};
+
+	struct Depth2 : Depth1
+	{
+
+	};
+
+	struct Depth3 : Depth2
+	{
+
+	};
+
+	struct Depth4 : Depth3
+	{
+
+	};
+
+	struct FlatDepth4 : Depth4
+	{
+
+	};
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "members")
+		[
+			class_<Depth0>("Depth0")
+				.def(constructor<>())
+				.def("get", &Depth0::get)
+				.def("add", &Depth0::add)
+				.def("add", &Depth0::add_s)
+				.def("add_default", &Depth0::add, 2)
+				.def<decltype(&Depth0::get), &Depth0::get>("static_get"),
+			class_<Depth1, Depth0>("Depth1")
+				.def(constructor<>()),
+			class_<Depth2, Depth1>("Depth2")
+				.def(constructor<>()),
+			class_<Depth3, Depth2>("Depth3")
+				.def(constructor<>()),
+			class_<Depth4, Depth3>("Depth4")
+				.def(constructor<>()),
+			class_<FlatDepth4, Depth4>("FlatDepth4", CLASS_FLATTEN)
+				.def(constructor<>())
+		];
+	}
+
+	const bench_case cases[] =
+	{
+		{ "call", "s = s + d0:get()" },
+		{ "call_static", "s = s + d0:static_get()" },
+		{ "call_args_2", "s = s + d0:add(i, 1)" },
+		{ "call_overload", "s = s + d0:add('a')" },
+		{ "call_default", "s = s + d0:add_default(i)" },
+		{ "call_cached", "s = s + get(d0)" },
+		{ "inherited_depth_1", "s = s + d1:get()" },
+		{ "inherited_depth_2", "s = s + d2:get()" },
+		{ "inherited_depth_3", "s = s + d3:get()" },
+		{ "inherited_depth_4", "s = s + d4:get()" },
+		{ "inherited_flat_depth_5", "s = s + f5:get()" },
+	};
+}
+
+BENCH_SUITE(members, &bind,
+	"local d0, d1, d2 = members.Depth0(), members.Depth1(), members.Depth2() "
+	"local d3, d4, f5 = members.Depth3(), members.Depth4(), members.FlatDepth4() "
+	"local get = d0.get", cases);
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   moves.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	struct Heavy
+	{
+		Heavy() noexcept
+			: payload(64, 1.0)
+		{
+
+		}
+
+		Heavy(const Heavy& other) noexcept
+			: payload(other.payload)
+		{
+			++bench_tracked.copies;
+		}
+
+		Heavy(Heavy&& other) noexcept
+			: payload(std::move(other.payload))
+		{
+			++bench_tracked.moves;
+		}
+
+		Heavy& operator = (const Heavy& other) noexcept
+		{
+			payload = other.payload;
+			++bench_tracked.copies;
+			return *this;
+		}
+
+		Heavy& operator = (Heavy&& other) noexcept
+		{
+			payload = std::move(other.payload);
+			++bench_tracked.moves;
+			return *this;
+		}
+
+		double front() noexcept
+		{
+			return payload.empty() ? 0 : payload.front();
+		}
+
+		Heavy clone() noexcept
+		{
+			return *this;
+		}
+
+		std::vector<double> payload;
+	};
+
+	Heavy make() noexcept
+	{
+		return Heavy();
+	}
+
+	double consume(Heavy h) noexcept
+	{
+		return h.front();
+	}
+
+	double inspect(const Heavy& h) noexcept
+	{
+		return h.payload.front();
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "moves")
+		[
+			def("make", &make),
+			def("consume", &consume),
+			def("inspect", &inspect),
+			class_<Heavy>("Heavy")
+				.def(constructor<>())
+				.def("front", &Heavy::front)
+				.def("clone", &Heavy::clone)
+		];
+		if (luaL_dostring(L, "function moves_sink(h) return h:front() end"))
+		{
+			fprintf(stderr, "%s\n", lua_tostring(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+
+	void callback_rvalue(lua_State* L, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = call_function<double>(L, "moves_sink", Heavy());
+		}
+	}
+
+	void callback_lvalue(lua_State* L, int n) noexcept
+	{
+		Heavy h;
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = call_function<double>(L, "moves_sink", h);
+		}
+	}
+
+	void callback_ref_rvalue(lua_State* L, int n) noexcept
+	{
+		function_ref<double> f(L, "moves_sink");
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = f(Heavy());
+		}
+	}
+
+	const bench_case cases[] =
+	{
+		{ "return_value", "s = s + make():front()", nullptr, 4 },
+		{ "return_member_value", "s = s + h:clone():front()", nullptr, 4 },
+		{ "pass_value", "s = s + consume(h)", nullptr, 4 },
+		{ "pass_const_ref", "s = s + inspect(h)" },
+		{ "callback_rvalue", nullptr, &callback_rvalue, 4 },
+		{ "callback_lvalue", nullptr, &callback_lvalue, 4 },
+		{ "callback_ref_rvalue", nullptr, &callback_ref_rvalue, 4 },
+	};
+}
+
+BENCH_SUITE(moves, &bind,
+	"local make, consume, inspect = moves.make, moves.consume, moves.inspect local h = moves.Heavy()", cases);
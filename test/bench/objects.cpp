@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   objects.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+using namespace luabind;
+
+namespace
+{
+	struct Point
+	{
+		int x = 1;
+		int y = 2;
+	};
+
+	struct Entity
+	{
+		int x = 1;
+	};
+
+	Point* create_point() noexcept
+	{
+		return new Point();
+	}
+
+	std::shared_ptr<Point> shared_point = std::make_shared<Point>();
+
+	std::shared_ptr<Entity> shared_entity = std::make_shared<Entity>();
+
+	std::shared_ptr<Point> get_point() noexcept
+	{
+		return shared_point;
+	}
+
+	std::shared_ptr<Entity> get_entity() noexcept
+	{
+		return shared_entity;
+	}
+
+	int scale(int a, int b) noexcept
+	{
+		return a * b;
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "objects")
+		[
+			def("scale", &scale),
+			class_<Point>("Point")
+				.def(constructor<>())
+				.def_new(&create_point)
+				.def("x", &Point::x),
+			def("get_point", &get_point),
+			class_<Entity>("Entity", CLASS_IDENTITY)
+				.def("x", &Entity::x),
+			def("get_entity", &get_entity)
+		];
+		if (luaL_dostring(L, "objects_data = { value = 1, nested = { value = 2 } }"))
+		{
+			fprintf(stderr, "%s\n", lua_tostring(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+
+	void object_copy(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["objects_data"];
+		for (int i = 0; i < n; ++i)
+		{
+			object c(o);
+			bench_sink = c.get_handle();
+		}
+	}
+
+	void object_copy_hold(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["objects_data"];
+		std::vector<object> copies(256);
+		for (int i = 0; i < n; ++i)
+		{
+			copies[i & 255] = o;
+		}
+		bench_sink = copies[0].get_handle();
+	}
+
+	void push_value(lua_State* L, int n) noexcept
+	{
+		Point p;
+		for (int i = 0; i < n; ++i)
+		{
+			type_traits<Point>::push(L, p);
+			lua_pop(L, 1);
+		}
+	}
+
+	void push_shared(lua_State* L, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			type_traits<std::shared_ptr<Point>>::push(L, shared_point);
+			lua_pop(L, 1);
+		}
+	}
+
+	void object_from_stack(lua_State* L, int n) noexcept
+	{
+		lua_pushinteger(L, 1);
+		for (int i = 0; i < n; ++i)
+		{
+			object c(L, -1);
+			bench_sink = c.get_handle();
+		}
+		lua_pop(L, 1);
+	}
+
+	void object_gettable(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["objects_data"];
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = o.gettable<int>("value");
+		}
+	}
+
+	void object_index(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["objects_data"];
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = o["value"].get<int>();
+		}
+	}
+
+	void object_index_nested(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["objects_data"];
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = o["nested"]["value"].get<int>();
+		}
+	}
+
+	void object_view_index_nested(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["objects_data"];
+		for (int i = 0; i < n; ++i)
+		{
+			LUABIND_HOLD_STACK(L);
+			bench_sink = o.view(L)["nested"]["value"].get<int>();
+		}
+	}
+
+	void call_function_dotted(lua_State* L, int n) noexcept
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = call_function<int>(L, "objects.scale", i, 2);
+		}
+	}
+
+	void call_function_object(lua_State* L, int n) noexcept
+	{
+		object f = globals(L)["objects"]["scale"];
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = call_function<int>(f, i, 2);
+		}
+	}
+
+	void call_function_ref(lua_State* L, int n) noexcept
+	{
+		function_ref<int> f(L, "objects.scale");
+		for (int i = 0; i < n; ++i)
+		{
+			bench_sink = f(i, 2);
+		}
+	}
+
+	const bench_case cases[] =
+	{
+		{ "constructor", "s = s + Point().x" },
+		{ "new_u", "s = s + Point.new_u().x" },
+		{ "new_s", "s = s + Point.new_s().x" },
+		{ "shared_getter", "s = s + objects.get_point().x" },
+		{ "shared_getter_identity", "s = s + objects.get_entity().x" },
+		{ "push_value", nullptr, &push_value },
+		{ "push_shared", nullptr, &push_shared },
+		{ "object_copy", nullptr, &object_copy },
+		{ "object_copy_hold", nullptr, &object_copy_hold },
+		{ "object_from_stack", nullptr, &object_from_stack },
+		{ "object_gettable", nullptr, &object_gettable },
+		{ "object_index", nullptr, &object_index },
+		{ "object_index_nested", nullptr, &object_index_nested },
+		{ "object_view_index_nested", nullptr, &object_view_index_nested },
+		{ "call_function_dotted", nullptr, &call_function_dotted },
+		{ "call_function_object", nullptr, &call_function_object },
+		{ "call_function_ref", nullptr, &call_function_ref },
+	};
+}
+
+BENCH_SUITE(objects, &bind, "local Point = objects.Point", cases);
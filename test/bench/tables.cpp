@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   tables.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+
+namespace
+{
+	struct Vec2
+	{
+		float x = 0;
+		float y = 0;
+	};
+
+	struct Message
+	{
+		int id = 0;
+		int channel = 0;
+		double stamp = 0;
+		bool reliable = false;
+		std::string sender;
+		Vec2 pos;
+	};
+}
+
+namespace luabind
+{
+	template <>
+	struct table_layout<Vec2>
+	{
+		static auto fields() noexcept
+		{
+			return std::make_tuple(
+				field("x", &Vec2::x),
+				field("y", &Vec2::y));
+		}
+	};
+
+	template <>
+	struct table_layout<Message>
+	{
+		static auto fields() noexcept
+		{
+			return std::make_tuple(
+				field("id", &Message::id),
+				field("channel", &Message::channel, 0),
+				field("stamp", &Message::stamp, 0.0),
+				field("reliable", &Message::reliable, false),
+				field("sender", &Message::sender, ""),
+				field("pos", &Message::pos, Vec2()));
+		}
+	};
+}
+
+using namespace luabind;
+
+namespace
+{
+	int message_id(const Message& m) noexcept
+	{
+		return m.id + (int)m.pos.x;
+	}
+
+	Message make_message(int id) noexcept
+	{
+		Message m;
+		m.id = id;
+		m.sender = "bench";
+		return m;
+	}
+
+	float sum_x(const std::vector<Vec2>& v) noexcept
+	{
+		float s = 0;
+		for (auto& p : v)
+		{
+			s += p.x;
+		}
+		return s;
+	}
+
+	void bind(lua_State* L) noexcept
+	{
+		module(L, "tables")
+		[
+			def("message_id", &message_id),
+			def("make_message", &make_message),
+			def("sum_x", &sum_x)
+		];
+		if (luaL_dostring(L, "tables_message = { id = 1, channel = 2, stamp = 0.5, "
+			"reliable = true, sender = 'bench', pos = { x = 1, y = 2 } }"))
+		{
+			fprintf(stderr, "%s\n", lua_tostring(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+
+	void manual_gettable(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["tables_message"];
+		for (int i = 0; i < n; ++i)
+		{
+			Message m;
+			m.id = o.gettable<int>("id");
+			m.channel = o.gettable<int>("channel");
+			m.stamp = o.gettable<double>("stamp");
+			m.reliable = o.gettable<bool>("reliable");
+			m.sender = o.gettable<std::string>("sender");
+			object pos = o.gettable<object>("pos");
+			m.pos.x = pos.gettable<float>("x");
+			m.pos.y = pos.gettable<float>("y");
+			bench_sink = m.id;
+		}
+	}
+
+	void codec_get(lua_State* L, int n) noexcept
+	{
+		object o = globals(L)["tables_message"];
+		for (int i = 0; i < n; ++i)
+		{
+			Message m = o.get<Message>();
+			bench_sink = m.id;
+		}
+	}
+
+	const bench_case cases[] =
+	{
+		{ "struct_param", "s = s + message_id(msg)" },
+		{ "struct_return", "s = s + make_message(i).id" },
+		{ "struct_vector_param_16", "s = s + sum_x(points)", nullptr, 16 },
+		{ "manual_gettable", nullptr, &manual_gettable },
+		{ "codec_get", nullptr, &codec_get },
+	};
+}
+
+BENCH_SUITE(tables, &bind,
+	"local message_id, make_message, sum_x = tables.message_id, tables.make_message, tables.sum_x "
+	"local msg = tables_message local points = {} for i = 1, 16 do points[i] = { x = i, y = 0 } end", cases);
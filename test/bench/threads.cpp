@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//  Copyright (c) 2016 Albert D Yang
+// -------------------------------------------------------------------------
+//  Module:      luabind_plus_bench
+//  File name:   threads.cpp
+//  Created:     2026/10/17 by agent
+//  Description:
+// -------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+// -------------------------------------------------------------------------
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+// -------------------------------------------------------------------------
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+#include "bench.h"
+#include <thread>
+
+using namespace luabind;
+
+namespace
+{
+	struct Counter : vtd::ref_obj
+	{
+		int value = 0;
+
+		int add(int v) noexcept
+		{
+			value += v;
+			return value;
+		}
+	};
+
+	Counter* shared_counter = []() noexcept
+	{
+		auto c = new Counter();
+		c->inc();
+		return c;
+	}();
+
+	Counter* get_shared() noexcept
+	{
+		return shared_counter;
+	}
+
+	int twice(int v) noexcept
+	{
+		return v * 2;
+	}
+
+	void bind(lua_State*) noexcept
+	{
+
+	}
+
+	void run_state(lua_State* L) noexcept
+	{
+		luaL_openlibs(L);
+		module(L, "threads")
+		[
+			class_<Counter>("Counter")
+				.def(constructor<>())
+				.def("value", &Counter::value)
+				.def("add", &Counter::add),
+			def("twice", &twice),
+			def("get_shared", &get_shared)
+		];
+		if (luaL_dostring(L, "local s = 0 for i = 1, 100 do local c = threads.Counter() "
+			"s = s + c:add(threads.twice(i)) + threads.get_shared().value end return s"))
+		{
+			fprintf(stderr, "threads: %s\n", lua_tostring(L, -1));
+			exit(1);
+		}
+		bench_sink = lua_tonumber(L, -1);
+		lua_close(L);
+	}
+
+	void worker(int count, bool pooled) noexcept
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (pooled)
+			{
+				pool_allocator pool;
+				run_state(pool.new_state());
+			}
+			else
+			{
+				run_state(luaL_newstate());
+			}
+		}
+	}
+
+	void states(lua_State*, int n) noexcept
+	{
+		int count = (int)std::thread::hardware_concurrency();
+		if (count < 1) count = 1;
+		std::vector<std::thread> workers;
+		for (int i = 0; i < count; ++i)
+		{
+			workers.emplace_back(&worker, n / count + (i < n % count ? 1 : 0), (i & 1) != 0);
+		}
+		for (auto& t : workers)
+		{
+			t.join();
+		}
+	}
+
+	const bench_case cases[] =
+	{
+		{ "states", nullptr, &states, 1000 },
+	};
+}
+
+BENCH_SUITE(threads, &bind, nullptr, cases);
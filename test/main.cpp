@@ -157,6 +157,21 @@ enum class TestEnum
 	test_enum3
 };
 
+int pick_cstr(const char* s) noexcept
+{
+	return 1;
+}
+
+int pick_string(std::string s) noexcept
+{
+	return 2;
+}
+
+int pick_number(double d) noexcept
+{
+	return 3;
+}
+
 int test_reader = 15;
 
 int test_reader2 = 30;
@@ -233,6 +248,11 @@ struct TestA : virtual vtd::ref_obj
 {
 	int a1 = 5, a2 = 6;
 	const int a3 = 7;
+
+	int get_a12()
+	{
+		return a1 + a2;
+	}
 };
 
 struct TestB : virtual vtd::ref_obj
@@ -265,6 +285,119 @@ void TestConvert(TestA a1, TestA& a2, std::shared_ptr<TestA> a3) noexcept
 
 }
 
+struct TestHidden
+{
+	int h = 7;
+
+	int get_h()
+	{
+		return h;
+	}
+};
+
+struct TestG : TestHidden
+{
+	int g = 1;
+};
+
+int pick_obj(TestA& a, double d) noexcept
+{
+	return 1;
+}
+
+int pick_obj(TestG& g, double d) noexcept
+{
+	return 2;
+}
+
+#ifdef LUABIND_HAS_STRING_VIEW
+size_t view_length(std::string_view s) noexcept
+{
+	return s.size();
+}
+
+std::string_view view_echo(std::string_view s) noexcept
+{
+	return s;
+}
+#endif
+
+struct TestE
+{
+	int e = 13;
+};
+
+std::shared_ptr<TestE> test_e = std::make_shared<TestE>();
+
+std::shared_ptr<TestE> get_e() noexcept
+{
+	return test_e;
+}
+
+std::weak_ptr<TestE> get_weak_e() noexcept
+{
+	return test_e;
+}
+
+int identity_stats(lua_State* L) noexcept
+{
+	luabind::env* e = luabind::get_env(L);
+	lua_pushinteger(L, (lua_Integer)e->identity_hits);
+	lua_pushinteger(L, (lua_Integer)e->identity_misses);
+	return 2;
+}
+
+struct LazyA
+{
+	int v = 1;
+
+	int get() noexcept
+	{
+		return v;
+	}
+};
+
+struct LazyB : LazyA
+{
+	int w = 2;
+};
+
+struct LazyC
+{
+	int c = 3;
+};
+
+struct LazyD : LazyC
+{
+
+};
+
+struct LazyE
+{
+	int e = 5;
+
+	int get() noexcept
+	{
+		return e;
+	}
+};
+
+luabind::yield_result<int, int> yield_pair(int a) noexcept
+{
+	return luabind::make_yield(a, a * 2);
+}
+
+struct TestY
+{
+	int n = 0;
+
+	luabind::yield_result<int> step(int v) noexcept
+	{
+		n += v;
+		return luabind::make_yield(n);
+	}
+};
+
 int test_val = 15;
 const int test_val2 = 16;
 
@@ -348,7 +481,7 @@ int main()
 			def_readonly("c2", &TestC::c2).
 			def_writeonly("c1", &TestC::c1),
 
-			class_<TestD, TestA, TestB, TestC>("TestD").
+			class_<TestD, TestA, TestB, TestC>("TestD", CLASS_FLATTEN).
 			def(constructor<>()).
 			def_readonly("d1", &TestD::d1).
 			def_readonly("d2", &TestD::d2).
@@ -356,6 +489,12 @@ int main()
 			def_writeonly("d1", &TestD::d1).
 			def_writer("p1", &TestD::setp),
 
+			class_<TestE>("TestE", CLASS_IDENTITY).
+			def_readonly("e", &TestE::e),
+			def("get_e", &get_e),
+			def("get_weak_e", &get_weak_e),
+			def_manual("identity_stats", &identity_stats),
+
 			enum_("EnumTest").
 			def("ENUM_1", ENUM_1, "e1").
 			def("ENUM_2", ENUM_2, "e2").
@@ -363,6 +502,11 @@ int main()
 			//def_manual_writer("test_reader", &writer)
 		];
 
+		module(L, "luabind")[
+			class_<TestA>("TestA").
+			def_reader("a12", &TestA::get_a12)
+		];
+
 		lua_pushcfunction(L, &lua_print);
 		lua_setglobal(L, "print");
 		int err(0);
@@ -407,7 +551,279 @@ int main()
 				}
 			}
 			int ret = call_function<int>(func);
-			ret = 0;
+			(void)ret;
+		}
+
+		{
+			function_ref<int> func(L, "test_lua_func");
+			int ret = func();
+			assert(ret == 5 && func() == 5);
+			(void)ret;
+		}
+
+		{
+			LUABIND_HOLD_STACK(L);
+			luaL_dostring(L, "function fr_test() return 1 end fr_group = { f = fr_test }");
+			function_ref<int> func(L, "fr_test");
+			function_ref<int> nested(L, "fr_group.f");
+			assert(func() == 1 && nested() == 1);
+			luaL_dostring(L, "function fr_test() return 2 end fr_group.f = fr_test");
+			assert(func() == 2 && nested() == 2);
+			luaL_dostring(L, "fr_group = { f = function() return 3 end }");
+			touch_functions(L);
+			assert(nested() == 3);
+			globals(L).rawset("fr_test", globals(L).rawget("test_lua_func"));
+			assert(func() == 5);
+			luaL_dostring(L, "fr_test = nil");
+			assert(!func.is_valid());
+		}
+
+		{
+			LUABIND_HOLD_STACK(L);
+			module(L, "luabind")[
+				def("pick", &pick_cstr),
+				def("pick", &pick_string),
+				def("pick", &pick_number)
+			];
+			int ret = luaL_dostring(L, "for i = 1, 3 do assert(luabind.pick('a') == 1 "
+				"and luabind.pick(i) == 3) end");
+			assert(!ret);
+			module(L, "luabind")[
+				def<decltype(&pick_number), &pick_number>("spick"),
+				class_<TestA>("TestA").
+				def<decltype(&TestA::get_a12), &TestA::get_a12>("sa12")
+			];
+			ret = luaL_dostring(L, "assert(luabind.spick(1) == 3 and luabind.TestA():sa12() == 11)");
+			assert(!ret);
+			module(L, "luabind")[
+				def<decltype(&pick_cstr), &pick_cstr>("spick")
+			];
+			ret = luaL_dostring(L, "assert(luabind.spick(1) == 3 and luabind.spick('a') == 1)");
+			assert(!ret);
+			(void)ret;
+		}
+
+		{
+			lua_State* L2 = luaL_newstate();
+			luaL_openlibs(L2);
+			module(L2, "m")[
+				def("add", &add)
+			];
+			int ret = luaL_dostring(L2, "assert(getmetatable(_G) == nil and m.add(1, 2) == 3)");
+			assert(!ret);
+			module(L2)[
+				namespace_("m")[
+					def("add2", &add)
+				],
+				def("radd", &add)
+			];
+			ret = luaL_dostring(L2, "assert(getmetatable(_G) and radd(1, 2) == 3 "
+				"and m.add(1, 2) == 3 and m.add2(1, 2) == 3)");
+			assert(!ret);
+			lua_close(L2);
+			(void)ret;
+		}
+
+		{
+			lua_State* states[2];
+			{
+				binding_set set("bs");
+				set[
+					def("add", &add, 1),
+					def("pick", &pick_cstr),
+					def("pick", &pick_number),
+					def<decltype(&pick_number), &pick_number>("spick"),
+					class_<TestA>("TestA").
+					def(constructor<>()).
+					def("a12", &TestA::get_a12)
+				];
+				for (auto& S : states)
+				{
+					S = luaL_newstate();
+					luaL_openlibs(S);
+					set.instantiate(S);
+				}
+				assert(set.get_stats().count == 2);
+			}
+			module(states[1], "bs")[
+				def("pick", &pick_string)
+			];
+			for (auto S : states)
+			{
+				int ret = luaL_dostring(S, "assert(bs.add(2) == 3 and bs.add(2, 3) == 5 "
+					"and bs.pick('a') == 1 and bs.pick(1) == 3 and bs.spick(1) == 3 "
+					"and bs.TestA():a12() == 11)");
+				assert(!ret);
+				(void)ret;
+			}
+			lua_close(states[0]);
+			lua_close(states[1]);
+		}
+
+		{
+			module(L, "luabind")[
+				class_<TestG>("TestG").
+				def(constructor<>()).
+				def("get_h", &TestG::get_h).
+				def<decltype(&TestG::get_h), &TestG::get_h>("sget_h"),
+				def("pick_obj", (int(*)(TestA&, double))&pick_obj),
+				def("pick_obj", (int(*)(TestG&, double))&pick_obj)
+			];
+			int ret = luaL_dostring(L, "local g = luabind.TestG() assert(g:get_h() == 7 and g:sget_h() == 7)");
+			assert(!ret);
+			ret = luaL_dostring(L, "local a, g = luabind.TestA(), luabind.TestG() "
+				"for i = 1, 3 do assert(luabind.pick_obj(a, i) == 1 and luabind.pick_obj(g, i) == 2) end");
+			assert(!ret);
+			(void)ret;
+		}
+
+		{
+			LUABIND_HOLD_STACK(L);
+			int ret = luaL_dostring(L, "luabind.TestClass1.val0 = 'abc'");
+			assert(ret && strstr(lua_tostring(L, -1), "not suitable"));
+			(void)ret;
+		}
+
+#		ifdef LUABIND_HAS_STRING_VIEW
+		{
+			LUABIND_HOLD_STACK(L);
+			module(L, "luabind")[
+				def("view_length", &view_length),
+				def("view_echo", &view_echo)
+			];
+			assert(call_function<size_t>(L, "luabind.view_length", std::string("a\0b", 3)) == 3);
+			int ret = luaL_dostring(L, "assert(luabind.view_echo('x\\0y') == 'x\\0y') luabind.view_length(1)");
+			assert(ret && strstr(lua_tostring(L, -1), "wrong params"));
+			(void)ret;
+		}
+#		endif
+
+		{
+			LUABIND_HOLD_STACK(L);
+			int values[3] = { 1, 2, 3 };
+			int top = lua_gettop(L);
+			int pushed = type_traits<std::tuple<span_view<int>, int>>::push(L,
+				std::make_tuple(span_view<int>(), 4));
+			assert(pushed == 2 && lua_gettop(L) == top + 2 && lua_isnil(L, -2));
+			type_traits<span_view<int>>::push(L, span_view<int>(values, 3));
+			lua_setglobal(L, "span_obj");
+			int ret = luaL_dostring(L, "span_obj[2] = 5 span_obj[4] = 1");
+			assert(ret && strstr(lua_tostring(L, -1), "span index 4 is out of range [1, 3]"));
+			assert(values[1] == 5);
+			luaL_dostring(L, "span_obj = nil");
+			(void)top;
+			(void)pushed;
+			(void)ret;
+		}
+
+		{
+			LUABIND_HOLD_STACK(L);
+			env* e = get_env(L);
+			auto obj = std::make_shared<TestE>();
+			std::weak_ptr<TestE> weak = obj;
+			type_traits<std::weak_ptr<TestE>>::push(L, weak);
+			size_t hits = e->identity_hits, misses = e->identity_misses;
+			type_traits<std::weak_ptr<TestE>>::push(L, weak);
+			assert(lua_rawequal(L, -1, -2) && e->identity_hits == hits + 1);
+			obj = std::make_shared<TestE>();
+			weak = obj;
+			type_traits<std::weak_ptr<TestE>>::push(L, weak);
+			assert(!lua_rawequal(L, -1, -2) && e->identity_misses == misses + 1);
+			obj.reset();
+			type_traits<std::weak_ptr<TestE>>::push(L, weak);
+			assert(!lua_rawequal(L, -1, -2) && e->identity_misses == misses + 1);
+			lua_settop(L, lua_gettop(L) - 4);
+			lua_gc(L, LUA_GCCOLLECT, 0);
+			obj = std::make_shared<TestE>();
+			type_traits<std::shared_ptr<TestE>>::push(L, obj);
+			lua_pop(L, 1);
+			lua_gc(L, LUA_GCCOLLECT, 0);
+			type_traits<std::shared_ptr<TestE>>::push(L, obj);
+			assert(e->identity_misses == misses + 3 && e->identity_hits == hits + 1);
+			lua_pop(L, 1);
+			weak = obj;
+			type_traits<std::shared_ptr<TestE>>::push(L, obj);
+			type_traits<std::weak_ptr<TestE>>::push(L, weak);
+			type_traits<std::shared_ptr<TestE>>::push(L, obj);
+			type_traits<std::weak_ptr<TestE>>::push(L, weak);
+			assert(lua_rawequal(L, -1, -3) && lua_rawequal(L, -2, -4) && !lua_rawequal(L, -1, -2));
+			assert(e->identity_hits == hits + 4);
+			(void)hits;
+			(void)misses;
+		}
+
+		{
+			LUABIND_HOLD_STACK(L);
+			env* e = get_env(L);
+			size_t classes = e->lazy_classes, materialized = e->lazy_materialized;
+			module(L, "lazy")[
+				class_<LazyA>("LazyA", CLASS_LAZY).
+				def(constructor<>()).
+				def("v", &LazyA::v).
+				def("get", &LazyA::get),
+				class_<LazyB, LazyA>("LazyB", CLASS_LAZY).
+				def(constructor<>()).
+				def("w", &LazyB::w),
+				class_<LazyE>("LazyE", CLASS_LAZY).
+				def(constructor<>()).
+				def("e", &LazyE::e)
+			];
+			assert(e->lazy_classes == classes + 3 && e->lazy_materialized == materialized);
+			type_traits<std::shared_ptr<LazyA>>::push(L, std::make_shared<LazyA>());
+			assert(e->lazy_materialized == materialized + 1);
+			lua_setglobal(L, "lazy_obj");
+			int ret = luaL_dostring(L, "assert(lazy_obj.v == 1 and lazy_obj:get() == 1) lazy_obj = nil");
+			assert(!ret && e->lazy_materialized == materialized + 1);
+			ret = luaL_dostring(L, "local b = lazy.LazyB() assert(b.w == 2 and b:get() == 1)");
+			assert(!ret && e->lazy_materialized == materialized + 2);
+			module(L, "lazy")[
+				class_<LazyC>("LazyC", CLASS_LAZY).
+				def("c", &LazyC::c),
+				class_<LazyD, LazyC>("LazyD").
+				def(constructor<>())
+			];
+			assert(e->lazy_classes == classes + 4 && e->lazy_materialized == materialized + 3);
+			ret = luaL_dostring(L, "assert(lazy.LazyD().c == 3)");
+			assert(!ret);
+			module(L, "lazy")[
+				class_<LazyE>("LazyE", CLASS_LAZY).
+				def("get", &LazyE::get)
+			];
+			assert(e->lazy_classes == classes + 4 && e->lazy_materialized == materialized + 4);
+			ret = luaL_dostring(L, "local x = lazy.LazyE() assert(x.e == 5 and x:get() == 5)");
+			assert(!ret);
+			(void)classes;
+			(void)materialized;
+			(void)ret;
+		}
+
+		{
+			LUABIND_HOLD_STACK(L);
+			module(L, "yielding")[
+				def("pair", &yield_pair),
+				class_<TestY>("TestY").
+				def(constructor<>()).
+				def("step", &TestY::step)
+			];
+			int ret = luaL_dostring(L, "function yielding_body(x) local a, b = yielding.pair(x) "
+				"local s = yielding.TestY():step(a + b) return s * 10 end "
+				"local f = coroutine.wrap(function() return yielding.pair(2) + 0 end) "
+				"local a, b = f() assert(a == 2 and b == 4 and f(5) == 5)");
+			assert(!ret);
+			lua_State* co = lua_newthread(L);
+			push_func_name(co, "yielding_body");
+			auto pair = resume_function<std::tuple<int, int>>(co, 3);
+			assert(lua_status(co) == LUA_YIELD && std::get<0>(pair) == 3 && std::get<1>(pair) == 6);
+			int step = resume_function<int>(co, 4, 5);
+			assert(lua_status(co) == LUA_YIELD && step == 9);
+			int res = resume_function<int>(co, 7);
+			assert(lua_status(co) == 0 && lua_gettop(co) == 0 && res == 70);
+			ret = luaL_dostring(L, "yielding.pair(1)");
+			assert(ret);
+			(void)pair;
+			(void)step;
+			(void)res;
+			(void)ret;
 		}
 
 		static_assert(count_func_params(&add) == 2, "");
@@ -29,6 +29,7 @@
 ////////////////////////////////////////////////////////////////////////////
 
 #include <type_traits>
+#include <atomic>
 #include "utility.h"
 
 namespace vtd
@@ -38,6 +39,16 @@ namespace vtd
 	public:
 		ref_obj() noexcept = default;
 
+		ref_obj(const ref_obj&) noexcept
+		{
+
+		}
+
+		ref_obj& operator = (const ref_obj&) noexcept
+		{
+			return *this;
+		}
+
 		virtual ~ref_obj() noexcept = default;
 
 		void inc() noexcept
@@ -47,8 +58,7 @@ namespace vtd
 
 		void dec() noexcept
 		{
-			--ref_count;
-			if (!ref_count)
+			if (!--ref_count)
 			{
 				delete_this();
 			}
@@ -66,7 +76,7 @@ namespace vtd
 		}
 
 	private:
-		size_t ref_count = 0;
+		std::atomic<size_t> ref_count{ 0 };
 	};
 
 	template <class _Ty>